@@ -37,6 +37,7 @@ check_function_exists( pthread_yield_np HAVE_YIELD_NP)
 check_function_exists( pthread_yield HAVE_YIELD)
 check_function_exists( fseeko HAVE_FSEEKO )
 check_function_exists( timegm HAVE_TIMEGM )
+check_function_exists( sched_getaffinity HAVE_SCHED_GETAFFINITY )
 
 check_function_exists( _mkdir HAVE_WINDOWS_MKDIR)
 if (NOT HAVE_WINDOWS_MKDIR)
@@ -26,6 +26,7 @@
 #include <ert/util/rng.h>
 #include <ert/util/matrix.h>
 #include <ert/util/matrix_blas.h>
+#include <ert/util/thread_pool.h>
 
 #include <ert/analysis/std_enkf.h>
 #include <ert/analysis/cv_enkf.h>
@@ -144,7 +145,7 @@ void bootstrap_enkf_updateA(void * module_data ,
 
   bootstrap_enkf_data_type * bootstrap_data = bootstrap_enkf_data_safe_cast( module_data );
   {
-    const int num_cpu_threads = 4;
+    const int num_cpu_threads = thread_pool_get_cpu_budget( );
     int ens_size              = matrix_get_columns( A );
     matrix_type * X           = matrix_alloc( ens_size , ens_size );
     matrix_type * A0          = matrix_alloc_copy( A );
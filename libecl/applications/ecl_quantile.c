@@ -39,11 +39,11 @@
 #include <ert/config/config_content_node.h>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
 
 #define DEFAULT_NUM_INTERP  50
 #define SUMMARY_JOIN       ":"
 #define MIN_SIZE            10
-#define LOAD_THREADS         4
 
 
 typedef enum {
@@ -124,7 +124,7 @@ static void quant_key_free__( void * qkey ) {
 sum_case_type * sum_case_fread_alloc( const char * data_file , const time_t_vector_type * interp_time ) {
   sum_case_type * sum_case = util_malloc( sizeof * sum_case );
 
-  sum_case->ecl_sum     = ecl_sum_fread_alloc_case( data_file , SUMMARY_JOIN );
+  sum_case->ecl_sum     = ecl_sum_fread_alloc_case_lazy( data_file , SUMMARY_JOIN );
   sum_case->interp_data = double_vector_alloc(0 , 0);
   sum_case->interp_time = interp_time;
   sum_case->start_time  = ecl_sum_get_start_time( sum_case->ecl_sum );
@@ -223,7 +223,7 @@ void ensemble_init( ensemble_type * ensemble , config_content_type * config) {
   /*1 : Loading ensembles and settings from the config instance */
   /*1a: Loading the eclipse summary cases. */
   {
-    thread_pool_type * tp = thread_pool_alloc( LOAD_THREADS , true );
+    thread_pool_type * tp = thread_pool_alloc( thread_pool_get_cpu_budget( ) , true );
     {
       int i,j;
       if (config_content_has_item( config , "CASE_LIST")) {
@@ -652,21 +652,42 @@ void output_run_line( const output_type * output , ensemble_type * ensemble) {
   /* The main loop - outer loop is running over time. */
   {
     /**
+       All the keys of one case are resampled onto the interp_time
+       grid in one go with ecl_sum_init_interp_matrix(); the values of
+       case iens are found in case_data[iens] organized as:
+
+          case_data[iens][column_nr * data_rows + row_nr]
+
        In the quite typical case that we are asking for several
        quantiles of the quantity, i.e.
 
        WWCT:OP_1:0.10  WWCT:OP_1:0.50  WWCT:OP_1:0.90
 
        the interp_data_cache construction will ensure that the
-       underlying ecl_sum object is only queried once; and also the
-       sorting will be performed once.
+       sorting is only performed once.
     */
 
+    const int ens_size = vector_get_size( ensemble->data );
+    double ** case_data = util_calloc( ens_size , sizeof * case_data );
     hash_type * interp_data_cache = hash_alloc();
 
+    for (int iens = 0; iens < ens_size; iens++) {
+      const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
+      ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( sum_case->ecl_sum );
+
+      for (column_nr = 0; column_nr < data_columns; column_nr++) {
+        const quant_key_type * qkey = vector_iget( output->keys , column_nr );
+        ecl_sum_vector_add_key( keylist , qkey->sum_key );
+      }
+
+      case_data[iens] = util_calloc( data_columns * data_rows , sizeof * case_data[iens] );
+      ecl_sum_init_interp_matrix( sum_case->ecl_sum , ensemble->interp_time , keylist , 0 , case_data[iens] );
+      ecl_sum_vector_free( keylist );
+    }
+
     for (row_nr = 0; row_nr < data_rows; row_nr++) {
       time_t interp_time = time_t_vector_iget( ensemble->interp_time , row_nr);
-      for (column_nr = 0; column_nr < vector_get_size( output->keys ); column_nr++) {
+      for (column_nr = 0; column_nr < data_columns; column_nr++) {
         const quant_key_type * qkey = vector_iget( output->keys , column_nr );
         double_vector_type * interp_data;
 
@@ -679,20 +700,23 @@ void output_run_line( const output_type * output , ensemble_type * ensemble) {
 
         /* Check if the vector has data - if not initialize it. */
         if (double_vector_size( interp_data ) == 0) {
-          for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
+          for (int iens = 0; iens < ens_size; iens++) {
             const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
 
             if ((interp_time >= sum_case->start_time) && (interp_time <= sum_case->end_time))  /* We allow the different simulations to have differing length */
-              double_vector_append( interp_data , ecl_sum_get_general_var_from_sim_time( sum_case->ecl_sum , interp_time , qkey->sum_key)) ;
-
-            double_vector_sort( interp_data );
+              double_vector_append( interp_data , case_data[iens][column_nr * data_rows + row_nr] );
           }
+          double_vector_sort( interp_data );
         }
         data[row_nr][column_nr] = statistics_empirical_quantile__( interp_data , qkey->quantile );
       }
       hash_apply( interp_data_cache , double_vector_reset__ );
     }
     hash_free( interp_data_cache );
+
+    for (int iens = 0; iens < ens_size; iens++)
+      free( case_data[iens] );
+    free( case_data );
   }
 
   output_save( output , ensemble , (const double **) data);
@@ -38,12 +38,25 @@ typedef enum {
                                     mainly to save filedescriptors in cases where many ecl_file instances are open at
                                     the same time. */
   //
-  ECL_FILE_WRITABLE      =  2    /*
+  ECL_FILE_WRITABLE      =  2 ,  /*
                                     This flag opens the file in a mode where it can be updated and modified, but it
                                     must still exist and be readable. I.e. this should not compared with the normal:
                                     fopen(filename , "w") where an existing file is truncated to zero upon successfull
                                     open.
                                  */
+  //
+  ECL_FILE_MMAP          =  4 ,  /*
+                                    This flag will memory map the file, build the keyword index by walking the
+                                    mapped region and load the keywords directly from the mapping instead of going
+                                    through the FILE * stream. Only used for unformatted files opened read-only;
+                                    if the file can not be mapped the normal stream based reading is used.
+                                 */
+  //
+  ECL_FILE_INDEX         =  8    /*
+                                    This flag will store the keyword index in a sidecar file '<filename>.index' and
+                                    reuse it on later opens, as long as the size and modification time of the file
+                                    are unchanged. See ecl_file_fast_open().
+                                 */
 } ecl_file_flag_type;
 
 
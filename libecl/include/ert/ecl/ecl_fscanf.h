@@ -0,0 +1,37 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_fscanf.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_ECL_FSCANF_H
+#define ERT_ECL_FSCANF_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdbool.h>
+
+  bool          ecl_fscanf_token( FILE * stream , char * buffer , int max_length);
+  const char  * ecl_fscanf_parse_int( const char * s , int * value );
+  const char  * ecl_fscanf_parse_double( const char * s , double * value );
+  const char  * ecl_fscanf_parse_repeat( const char * s , int * multiplier );
+  int           ecl_fscanf_sprintf_scientific( char * buffer , int digits , char exp_char , double x);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -90,6 +90,9 @@ extern "C" {
   bool            ecl_grid_cell_contains3(const ecl_grid_type * grid , int i , int j ,int k , double x , double y , double z);
   int             ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index);
   bool            ecl_grid_get_ijk_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index, int *i, int *j, int *k );
+  void            ecl_grid_init_xyz_index( ecl_grid_type * grid );
+  bool            ecl_grid_has_xyz_index( const ecl_grid_type * grid );
+  int             ecl_grid_locate_xyz( const ecl_grid_type * grid , double x , double y , double z);
   bool            ecl_grid_get_ij_from_xy( const ecl_grid_type * grid , double x , double y , int k , int* i, int* j);
   const  char   * ecl_grid_get_name( const ecl_grid_type * );
   int             ecl_grid_get_active_index3(const ecl_grid_type * ecl_grid , int i , int j , int k);
@@ -232,6 +235,9 @@ extern "C" {
 
   void             ecl_grid_ri_export( const ecl_grid_type * ecl_grid , double * ri_points);
   void             ecl_grid_cell_ri_export( const ecl_grid_type * ecl_grid , int global_index , double * ri_points);
+  void             ecl_grid_export_index( const ecl_grid_type * grid , int * global_index , int * i , int * j , int * k);
+  void             ecl_grid_export_volume( const ecl_grid_type * grid , double * volume );
+  void             ecl_grid_export_position( const ecl_grid_type * grid , double * x , double * y , double * z);
 
   bool             ecl_grid_dual_grid( const ecl_grid_type * ecl_grid );
   int              ecl_grid_get_num_nnc( const ecl_grid_type * grid );
@@ -91,6 +91,7 @@ extern "C" {
   ecl_kw_type *  ecl_kw_fread_alloc(fortio_type *);
   void           ecl_kw_free_data(ecl_kw_type *);
   void           ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ecl_data_type, int element_count, const int_vector_type* index_map, char* buffer);
+  offset_type    ecl_kw_unformatted_element_offset( offset_type kw_offset , ecl_data_type data_type , int index );
   void           ecl_kw_free(ecl_kw_type *);
   void           ecl_kw_free__(void *);
   ecl_kw_type *  ecl_kw_alloc_copy (const ecl_kw_type *);
@@ -107,6 +108,7 @@ extern "C" {
   void           ecl_kw_get_memcpy_int_data(const ecl_kw_type *ecl_kw , int *target);
   void           ecl_kw_set_memcpy_data(ecl_kw_type * , const void *);
   void           ecl_kw_fwrite(const ecl_kw_type *,  fortio_type *);
+  void           ecl_kw_fwrite_header(const ecl_kw_type *ecl_kw , fortio_type *fortio);
   void           ecl_kw_iget(const ecl_kw_type *, int , void *);
   void           ecl_kw_iset(ecl_kw_type *ecl_kw , int i , const void *iptr);
   void           ecl_kw_iset_char_ptr( ecl_kw_type * ecl_kw , int index, const char * s);
@@ -138,6 +140,10 @@ extern "C" {
   bool           ecl_kw_fskip_data__( ecl_data_type, int, fortio_type *);
   bool           ecl_kw_fskip_data(ecl_kw_type *ecl_kw, fortio_type *fortio);
   bool           ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio);
+  ecl_read_status_enum ecl_kw_mmap_header( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset);
+  bool           ecl_kw_mmap_data( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset);
+  bool           ecl_kw_mmap_skip_data__( ecl_data_type data_type , int element_count , const fortio_type * fortio , offset_type * offset);
+  ecl_kw_type *  ecl_kw_mmap_alloc( const fortio_type * fortio , offset_type offset );
   void           ecl_kw_fskip_header( fortio_type * fortio);
 
 
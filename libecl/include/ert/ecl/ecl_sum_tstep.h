@@ -40,6 +40,11 @@ typedef struct ecl_sum_tstep_struct ecl_sum_tstep_type;
                                                      const char * src_file ,
                                                      const ecl_smspec_type * smspec);
 
+  ecl_sum_tstep_type * ecl_sum_tstep_alloc_lazy( int report_step , int ministep_nr , const float * params , offset_type file_offset , const ecl_smspec_type * smspec);
+  bool                 ecl_sum_tstep_is_loaded( const ecl_sum_tstep_type * ministep );
+  offset_type          ecl_sum_tstep_get_file_offset( const ecl_sum_tstep_type * ministep );
+  void                 ecl_sum_tstep_load_data( ecl_sum_tstep_type * ministep , const ecl_kw_type * params_kw );
+
   ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , float sim_seconds , const ecl_smspec_type * smspec );
 
   double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index);
@@ -39,6 +39,12 @@ typedef struct ecl_sum_vector_struct ecl_sum_vector_type;
   int ecl_sum_vector_iget_param_index(const ecl_sum_vector_type * ecl_sum_vector, int index);
   int ecl_sum_vector_get_size(const ecl_sum_vector_type * ecl_sum_vector);
 
+  /*
+    Evaluates all the keys at all the (sorted) times, the values are
+    stored as values[ikey * num_times + itime].
+  */
+  void ecl_sum_init_interp_matrix( const ecl_sum_type * ecl_sum , const time_t_vector_type * sim_times , const ecl_sum_vector_type * keylist , double missing_value , double * values);
+
   UTIL_IS_INSTANCE_HEADER( ecl_sum_vector);
 
 
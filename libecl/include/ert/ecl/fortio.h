@@ -59,6 +59,8 @@ typedef struct fortio_struct fortio_type;
   void               fortio_fskip_buffer(fortio_type *, int );
   int                fortio_fskip_record(fortio_type *);
   bool               fortio_fread_buffer(fortio_type * , char * buffer, int buffer_size);
+  bool               fortio_fread_blocks(fortio_type * fortio , char * buffer , int element_size , int elements , int block_elements , bool flip_data);
+  void               fortio_fwrite_blocks(fortio_type * fortio , const char * buffer , int element_size , int elements , int block_elements , bool flip_data);
   void               fortio_fwrite_record(fortio_type * , const char * buffer, int buffer_size);
   FILE        *      fortio_get_FILE(const fortio_type *);
   void               fortio_fflush(fortio_type * ) ;
@@ -70,6 +72,7 @@ typedef struct fortio_struct fortio_type;
   offset_type        fortio_ftell( const fortio_type * fortio );
   bool               fortio_fseek( fortio_type * fortio , offset_type offset , int whence);
   bool               fortio_data_fskip(fortio_type* fortio, const int element_size, const int element_count, const int block_count);
+  offset_type        fortio_data_element_offset(offset_type data_offset, size_t data_element, const int element_size, const int block_size);
   void               fortio_data_fseek(fortio_type* fortio, offset_type data_offset, size_t data_element, const int element_size, const int element_count, const int block_size);
   int                fortio_fileno( fortio_type * fortio );
   bool               fortio_ftruncate( fortio_type * fortio , offset_type size);
@@ -80,6 +83,13 @@ typedef struct fortio_struct fortio_type;
   bool               fortio_assert_stream_open( fortio_type * fortio );
   bool               fortio_read_at_eof( fortio_type * fortio );
 
+  bool               fortio_mmap( fortio_type * fortio );
+  void               fortio_munmap( fortio_type * fortio );
+  bool               fortio_is_mmapped( const fortio_type * fortio );
+  offset_type        fortio_mmap_size( const fortio_type * fortio );
+  int                fortio_mmap_record_size( const fortio_type * fortio , offset_type offset );
+  const char  *      fortio_mmap_record( const fortio_type * fortio , offset_type * offset , int * record_size);
+
 UTIL_IS_INSTANCE_HEADER( fortio );
 UTIL_SAFE_CAST_HEADER( fortio );
 
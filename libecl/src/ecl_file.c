@@ -27,6 +27,10 @@
 #include <ert/util/vector.h>
 #include <ert/util/int_vector.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/ert_api_config.h>
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
 
 #include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_kw.h>
@@ -558,6 +562,416 @@ static bool ecl_file_scan( ecl_file_type * ecl_file ) {
 }
 
 
+/*
+  Scan function used by ecl_file_open_restart_subset(). Only the
+  keywords in @kw_list, and only in the SEQNUM blocks with a report
+  step in @report_steps, are added to the index; all other keywords
+  are skipped without being indexed. The restart header keywords
+  SEQNUM, INTEHEAD, LOGIHEAD and DOUBHEAD are always added for the
+  selected blocks, so that the restart view functions continue to
+  work. When all the requested report steps have been found the scan
+  stops without reading the remaining part of the file.
+
+  Keywords before the first SEQNUM keyword, i.e. all keywords in a
+  non-unified restart file, are considered to belong to the report
+  step @first_report_step.
+*/
+
+static bool ecl_file_scan_restart_kw( const char * header , const stringlist_type * kw_list ) {
+  if (kw_list == NULL)
+    return true;
+
+  if ((strcmp( header , SEQNUM_KW ) == 0) ||
+      (strcmp( header , INTEHEAD_KW ) == 0) ||
+      (strcmp( header , LOGIHEAD_KW ) == 0) ||
+      (strcmp( header , DOUBHEAD_KW ) == 0))
+    return true;
+
+  return stringlist_contains( kw_list , header );
+}
+
+
+static bool ecl_file_scan_restart_subset( ecl_file_type * ecl_file , const stringlist_type * kw_list , const int_vector_type * report_steps , int first_report_step) {
+  bool scan_ok = false;
+  int_vector_type * remaining_steps = NULL;
+  bool block_active;
+
+  if (report_steps) {
+    remaining_steps = int_vector_alloc_copy( report_steps );
+    int_vector_select_unique( remaining_steps );
+    block_active = int_vector_contains( remaining_steps , first_report_step );
+  } else
+    block_active = true;
+
+  fortio_fseek( ecl_file->fortio , 0 , SEEK_SET );
+  {
+    ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT , NULL);
+
+    while (true) {
+      if (fortio_read_at_eof(ecl_file->fortio)) {
+        scan_ok = true;
+        break;
+      }
+
+      {
+        offset_type current_offset = fortio_ftell( ecl_file->fortio );
+        ecl_read_status_enum read_status = ecl_kw_fread_header( work_kw , ecl_file->fortio);
+        if (read_status == ECL_KW_READ_FAIL)
+          break;
+
+        if ((read_status == ECL_KW_READ_OK) && ecl_kw_name_equal( work_kw , SEQNUM_KW ) && remaining_steps) {
+          int index;
+          ecl_kw_type * seqnum_kw;
+
+          fortio_fseek( ecl_file->fortio , current_offset , SEEK_SET );
+          seqnum_kw = ecl_kw_fread_alloc( ecl_file->fortio );
+          if (seqnum_kw == NULL)
+            break;
+
+          if (int_vector_size( remaining_steps ) == 0) {
+            /* All the requested report steps have been found. */
+            ecl_kw_free( seqnum_kw );
+            scan_ok = true;
+            break;
+          }
+
+          index = int_vector_index_sorted( remaining_steps , ecl_kw_iget_int( seqnum_kw , 0 ));
+          block_active = (index >= 0);
+          if (block_active) {
+            int_vector_idel( remaining_steps , index );
+            ecl_file_view_add_kw( ecl_file->global_view , ecl_file_kw_alloc( seqnum_kw , current_offset ));
+          }
+
+          ecl_kw_free( seqnum_kw );
+          continue;
+        }
+
+        if ((read_status == ECL_KW_READ_OK) && block_active && ecl_file_scan_restart_kw( ecl_kw_get_header( work_kw ) , kw_list )) {
+          ecl_file_kw_type * file_kw = ecl_file_kw_alloc( work_kw , current_offset);
+          if (ecl_file_kw_fskip_data( file_kw , ecl_file->fortio ))
+            ecl_file_view_add_kw( ecl_file->global_view , file_kw );
+          else {
+            ecl_file_kw_free( file_kw );
+            break;
+          }
+        } else {
+          if (!ecl_kw_fskip_data( work_kw , ecl_file->fortio ))
+            break;
+        }
+      }
+    }
+
+    ecl_kw_free( work_kw );
+  }
+
+  if (remaining_steps)
+    int_vector_free( remaining_steps );
+
+  if (scan_ok)
+    ecl_file_view_make_index( ecl_file->global_view );
+
+  return scan_ok;
+}
+
+
+/*****************************************************************/
+/*
+  Scanning of memory mapped files. The keyword headers are read
+  directly from the mapped region and the data sections are skipped
+  with pure offset arithmetic, i.e. only the pages containing headers
+  are touched.
+
+  For large files the scan is split in segments which are scanned
+  concurrently. Since the keyword boundaries are not known in advance
+  each segment starts by searching forward from the segment start for
+  something which looks like a keyword header; from there the chain
+  of keywords is followed to the end of the segment. When the
+  segments are merged the chain from the previous segment must hit a
+  keyword offset found in the next segment, otherwise the scan falls
+  back to following the chain one keyword at a time until it is in
+  sync again. That way a false match in the header search is never
+  trusted, and the result is identical to a sequential scan.
+*/
+
+#define ECL_FILE_SCAN_THREADS      4
+#define ECL_FILE_SCAN_MIN_SEGMENT  (64 * 1024 * 1024)
+
+typedef struct {
+  const fortio_type * fortio;
+  offset_type         start;
+  offset_type         end;
+  offset_type         next_offset;   /* The offset after the last keyword in kw_list. */
+  bool                scan_ok;       /* Did the chain reach the end of the segment. */
+  vector_type       * kw_list;
+} ecl_file_scan_segment_type;
+
+
+/*
+  Follows the chain of keywords starting at *offset, and appends an
+  ecl_file_kw instance for each keyword to @kw_list, until *offset is
+  at or beyond @end. Returns false if an invalid header, or a data
+  section extending beyond the end of the file, is encountered; in
+  that case *offset is the offset of the offending keyword.
+*/
+
+static bool ecl_file_scan_mmap_range( const fortio_type * fortio , offset_type * offset , offset_type end , vector_type * kw_list) {
+  bool scan_ok = true;
+  ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT , NULL);
+
+  while (*offset < end) {
+    offset_type current_offset = *offset;
+    ecl_read_status_enum read_status = ecl_kw_mmap_header( work_kw , fortio , offset );
+
+    if ((read_status == ECL_KW_READ_FAIL) ||
+        !ecl_kw_mmap_skip_data__( ecl_kw_get_data_type( work_kw ) , ecl_kw_get_size( work_kw ) , fortio , offset )) {
+      *offset = current_offset;
+      scan_ok = false;
+      break;
+    }
+
+    if (read_status == ECL_KW_READ_OK)
+      vector_append_owned_ref( kw_list , ecl_file_kw_alloc( work_kw , current_offset ) , ecl_file_kw_free__ );
+    else
+      fprintf(stderr,"** Warning: keyword %s is of type \'C010\' - will be skipped when loading file.\n" , ecl_kw_get_header( work_kw ));
+  }
+
+  ecl_kw_free( work_kw );
+  return scan_ok;
+}
+
+
+/*
+  Searches forward from *offset for a position which looks like the
+  start of a keyword; i.e. a valid header where the data section is
+  followed either by another valid header or by the end of the file.
+*/
+
+static bool ecl_file_scan_mmap_find_header( const fortio_type * fortio , offset_type * offset , offset_type end) {
+  ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT , NULL);
+  offset_type pos = *offset;
+  bool found = false;
+
+  while (!found && (pos < end)) {
+    offset_type next = pos;
+    if (ecl_kw_mmap_header( work_kw , fortio , &next ) != ECL_KW_READ_FAIL) {
+      if (ecl_kw_mmap_skip_data__( ecl_kw_get_data_type( work_kw ) , ecl_kw_get_size( work_kw ) , fortio , &next )) {
+        if (next == fortio_mmap_size( fortio ))
+          found = true;
+        else if (ecl_kw_mmap_header( work_kw , fortio , &next ) != ECL_KW_READ_FAIL)
+          found = true;
+      }
+    }
+
+    if (!found)
+      pos++;
+  }
+
+  ecl_kw_free( work_kw );
+  *offset = pos;
+  return found;
+}
+
+
+static void * ecl_file_scan_mmap_segment__( void * arg ) {
+  ecl_file_scan_segment_type * segment = (ecl_file_scan_segment_type *) arg;
+  offset_type offset = segment->start;
+
+  if (ecl_file_scan_mmap_find_header( segment->fortio , &offset , segment->end ))
+    segment->scan_ok = ecl_file_scan_mmap_range( segment->fortio , &offset , segment->end , segment->kw_list );
+
+  segment->next_offset = offset;
+  return NULL;
+}
+
+
+/*
+  Binary search in the kw_list of a segment for a keyword starting at
+  @offset; the offsets in the list are strictly increasing.
+*/
+
+static int ecl_file_scan_segment_find( const ecl_file_scan_segment_type * segment , offset_type offset) {
+  int lower = 0;
+  int upper = vector_get_size( segment->kw_list ) - 1;
+
+  while (lower <= upper) {
+    int mid = (lower + upper) / 2;
+    offset_type mid_offset = ecl_file_kw_get_offset( vector_iget_const( segment->kw_list , mid ));
+    if (mid_offset == offset)
+      return mid;
+
+    if (mid_offset < offset)
+      lower = mid + 1;
+    else
+      upper = mid - 1;
+  }
+  return -1;
+}
+
+
+static void ecl_file_add_kw_copies( ecl_file_type * ecl_file , const vector_type * kw_list , int index1 , int index2) {
+  int index;
+  for (index = index1; index < index2; index++)
+    ecl_file_view_add_kw( ecl_file->global_view , ecl_file_kw_alloc_copy( vector_iget_const( kw_list , index )));
+}
+
+
+static bool ecl_file_scan_mmap( ecl_file_type * ecl_file ) {
+  const fortio_type * fortio = ecl_file->fortio;
+  const offset_type file_size = fortio_mmap_size( fortio );
+  const int num_segments = util_int_min( ECL_FILE_SCAN_THREADS , 1 + (int) (file_size / ECL_FILE_SCAN_MIN_SEGMENT));
+  ecl_file_scan_segment_type * segments = util_calloc( num_segments , sizeof * segments );
+  offset_type offset = 0;
+  bool scan_ok = true;
+  int iseg;
+
+  for (iseg = 0; iseg < num_segments; iseg++) {
+    ecl_file_scan_segment_type * segment = &segments[iseg];
+    segment->fortio  = fortio;
+    segment->start   = (file_size / num_segments) * iseg;
+    segment->end     = (iseg == (num_segments - 1)) ? file_size : (file_size / num_segments) * (iseg + 1);
+    segment->scan_ok = false;
+    segment->kw_list = vector_alloc_new();
+  }
+
+#ifdef ERT_HAVE_THREAD_POOL
+  if (num_segments > 1) {
+    thread_pool_type * tp = thread_pool_alloc( num_segments , true );
+    for (iseg = 0; iseg < num_segments; iseg++)
+      thread_pool_add_job( tp , ecl_file_scan_mmap_segment__ , &segments[iseg] );
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+  } else
+#endif
+  {
+    for (iseg = 0; iseg < num_segments; iseg++)
+      ecl_file_scan_mmap_segment__( &segments[iseg] );
+  }
+
+  for (iseg = 0; iseg < num_segments; iseg++) {
+    const ecl_file_scan_segment_type * segment = &segments[iseg];
+    while (scan_ok && (offset < segment->end)) {
+      int index = ecl_file_scan_segment_find( segment , offset );
+      int size = vector_get_size( segment->kw_list );
+
+      if (index >= 0) {
+        if (segment->scan_ok) {
+          ecl_file_add_kw_copies( ecl_file , segment->kw_list , index , size );
+          offset = segment->next_offset;
+        } else {
+          /*
+            The chain broke down inside the segment; we take the keywords
+            up to the last one and let the sequential stepping below
+            find the error - if any.
+          */
+          ecl_file_add_kw_copies( ecl_file , segment->kw_list , index , size - 1 );
+          offset = ecl_file_kw_get_offset( vector_iget_const( segment->kw_list , size - 1 ));
+          index = -1;
+        }
+      }
+
+      if ((index < 0) && (offset < segment->end)) {
+        vector_type * kw_list = vector_alloc_new();
+        scan_ok = ecl_file_scan_mmap_range( fortio , &offset , offset + 1 , kw_list );
+        ecl_file_add_kw_copies( ecl_file , kw_list , 0 , vector_get_size( kw_list ));
+        vector_free( kw_list );
+      }
+    }
+    vector_free( segment->kw_list );
+  }
+  free( segments );
+
+  if (offset != file_size)
+    scan_ok = false;
+
+  if (scan_ok)
+    ecl_file_view_make_index( ecl_file->global_view );
+
+  return scan_ok;
+}
+
+
+/*****************************************************************/
+/*
+  The index built by the scan can be stored in a separate index file
+  with ecl_file_write_index(), and reloaded when the file is opened
+  again with ecl_file_fast_open(). The index file contains the size
+  and modification time of the source file, and it is only used if
+  these still agree with the source file.
+*/
+
+#define ECL_FILE_INDEX_ID 776108
+
+
+bool ecl_file_write_index( const ecl_file_type * ecl_file , const char * index_filename ) {
+  const char * src_file = fortio_filename_ref( ecl_file->fortio );
+  char * tmp_file = util_alloc_sprintf("%s.tmp" , index_filename );
+  FILE * stream = util_fopen__( tmp_file , "wb");
+  bool write_ok = false;
+
+  if (stream) {
+    offset_type src_size = util_file_size( src_file );
+    int size = ecl_file_view_get_size( ecl_file->global_view );
+    int index;
+
+    util_fwrite_int( ECL_FILE_INDEX_ID , stream );
+    util_fwrite( &src_size , sizeof src_size , 1 , stream , __func__ );
+    util_fwrite_time_t( util_file_mtime( src_file ) , stream );
+    util_fwrite_int( size , stream );
+    for (index = 0; index < size; index++)
+      ecl_file_kw_fwrite( ecl_file_view_iget_file_kw( ecl_file->global_view , index ) , stream );
+    util_fwrite_int( ECL_FILE_INDEX_ID , stream );
+    fclose( stream );
+
+    /* The index is written to a temporary file and renamed, so a partially written index is never seen. */
+    write_ok = (rename( tmp_file , index_filename ) == 0);
+    if (!write_ok)
+      remove( tmp_file );
+  }
+
+  free( tmp_file );
+  return write_ok;
+}
+
+
+static bool ecl_file_load_index( ecl_file_type * ecl_file , const char * index_filename ) {
+  const char * src_file = fortio_filename_ref( ecl_file->fortio );
+  FILE * stream = util_fopen__( index_filename , "rb");
+  bool load_ok = false;
+
+  if (stream) {
+    int id , size;
+    offset_type src_size;
+    time_t src_mtime;
+
+    if ((fread( &id , sizeof id , 1 , stream ) == 1) &&
+        (fread( &src_size , sizeof src_size , 1 , stream ) == 1) &&
+        (fread( &src_mtime , sizeof src_mtime , 1 , stream ) == 1) &&
+        (fread( &size , sizeof size , 1 , stream ) == 1)) {
+
+      if ((id == ECL_FILE_INDEX_ID) &&
+          (src_size == (offset_type) util_file_size( src_file )) &&
+          (src_mtime == util_file_mtime( src_file ))) {
+        vector_type * kw_list = vector_alloc_new();
+        int index;
+
+        for (index = 0; index < size; index++)
+          vector_append_owned_ref( kw_list , ecl_file_kw_fread_alloc( stream ) , ecl_file_kw_free__ );
+
+        if ((fread( &id , sizeof id , 1 , stream ) == 1) && (id == ECL_FILE_INDEX_ID)) {
+          ecl_file_add_kw_copies( ecl_file , kw_list , 0 , size );
+          ecl_file_view_make_index( ecl_file->global_view );
+          load_ok = true;
+        }
+        vector_free( kw_list );
+      }
+    }
+    fclose( stream );
+  }
+
+  return load_ok;
+}
+
+
 void ecl_file_select_global( ecl_file_type * ecl_file ) {
   ecl_file->active_view = ecl_file->global_view;
 }
@@ -573,10 +987,19 @@ void ecl_file_select_global( ecl_file_type * ecl_file ) {
 
    The ecl_file instance will retain an open fortio reference to the
    file until ecl_file_close() is called.
+
+   If the flag ECL_FILE_MMAP is set the file is memory mapped, and
+   both the scan and the subsequent loading of keywords work directly
+   on the mapped region. Combined with ECL_FILE_CLOSE_STREAM this means
+   that no file descriptor is held open after the scan.
+
+   If the flag ECL_FILE_INDEX is set the keyword index is loaded from
+   the file '<filename>.index' if that is up to date, otherwise the
+   file is scanned and the index file is (re)written.
 */
 
 
-ecl_file_type * ecl_file_open( const char * filename , int flags) {
+static ecl_file_type * ecl_file_open__( const char * filename , const char * index_filename , const stringlist_type * kw_list , const int_vector_type * report_steps , int flags) {
   fortio_type * fortio;
   bool          fmt_file;
 
@@ -589,10 +1012,43 @@ ecl_file_type * ecl_file_open( const char * filename , int flags) {
 
   if (fortio) {
     ecl_file_type * ecl_file = ecl_file_alloc_empty( flags );
+    bool index_ok = false;
+    bool scan_ok;
+
     ecl_file->fortio = fortio;
     ecl_file->global_view = ecl_file_view_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_view , true );
 
-    if (ecl_file_scan( ecl_file )) {
+    if (index_filename)
+      index_ok = ecl_file_load_index( ecl_file , index_filename );
+
+    /*
+      When the index must be built the file is mapped for the duration
+      of the scan also when ECL_FILE_MMAP has not been requested, to
+      be able to use the parallel scan.
+    */
+    if (!ecl_file_view_check_flags( flags , ECL_FILE_WRITABLE)) {
+      if (ecl_file_view_check_flags( flags , ECL_FILE_MMAP) || (index_filename && !index_ok))
+        fortio_mmap( ecl_file->fortio );
+    }
+
+    if (index_ok)
+      scan_ok = true;
+    else if (kw_list || report_steps) {
+      int first_report_step = -1;
+      ecl_util_get_file_type( filename , NULL , &first_report_step );
+      scan_ok = ecl_file_scan_restart_subset( ecl_file , kw_list , report_steps , first_report_step );
+    } else if (fortio_is_mmapped( ecl_file->fortio ))
+      scan_ok = ecl_file_scan_mmap( ecl_file );
+    else
+      scan_ok = ecl_file_scan( ecl_file );
+
+    if (scan_ok) {
+      if (index_filename && !index_ok)
+        ecl_file_write_index( ecl_file , index_filename );
+
+      if (!ecl_file_view_check_flags( flags , ECL_FILE_MMAP))
+        fortio_munmap( ecl_file->fortio );
+
       ecl_file_select_global( ecl_file );
 
       if (ecl_file_view_check_flags( ecl_file->flags , ECL_FILE_CLOSE_STREAM))
@@ -608,6 +1064,48 @@ ecl_file_type * ecl_file_open( const char * filename , int flags) {
 }
 
 
+ecl_file_type * ecl_file_open( const char * filename , int flags) {
+  if (ecl_file_view_check_flags( flags , ECL_FILE_INDEX)) {
+    char * index_filename = util_alloc_sprintf("%s.index" , filename );
+    ecl_file_type * ecl_file = ecl_file_open__( filename , index_filename , NULL , NULL , flags );
+    free( index_filename );
+    return ecl_file;
+  } else
+    return ecl_file_open__( filename , NULL , NULL , NULL , flags );
+}
+
+
+/**
+   Will open the file @filename using the keyword index stored in
+   @index_filename. If the index file does not exist, or it does not
+   match the size and modification time of @filename, the file is
+   scanned and a new index is written to @index_filename. Apart from
+   that this behaves as ecl_file_open().
+*/
+
+ecl_file_type * ecl_file_fast_open( const char * filename , const char * index_filename , int flags) {
+  return ecl_file_open__( filename , index_filename , NULL , NULL , flags );
+}
+
+
+/**
+   Will open the restart file @filename, but only index the keywords
+   in @kw_list, in the report steps in @report_steps; the other
+   keywords are skipped during the scan and will not be visible in the
+   returned ecl_file instance. The SEQNUM, INTEHEAD, LOGIHEAD and
+   DOUBHEAD keywords of the selected report steps are always included,
+   so the restart view functions, e.g. ecl_file_get_restart_view(),
+   can be used on the returned instance.
+
+   Both @kw_list and @report_steps can be NULL, meaning all keywords
+   and all report steps respectively. The ECL_FILE_INDEX flag is
+   ignored.
+*/
+
+ecl_file_type * ecl_file_open_restart_subset( const char * filename , const stringlist_type * kw_list , const int_vector_type * report_steps , int flags) {
+  return ecl_file_open__( filename , NULL , kw_list , report_steps , flags );
+}
+
 
 
 
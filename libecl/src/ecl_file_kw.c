@@ -39,7 +39,9 @@
   If and when the keyword is actually queried for at a later stage the
   ecl_file_kw_get_kw() method will seek to the keyword position in an
   open fortio instance and call ecl_kw_fread_alloc() to instantiate
-  the keyword itself.
+  the keyword itself. If the fortio instance has been memory mapped
+  the keyword is instead assembled directly from the mapping with
+  ecl_kw_mmap_alloc().
 
   The ecl_file_kw datatype is mainly used by the ecl_file datatype;
   whose index tables consists of ecl_file_kw instances.
@@ -175,6 +177,37 @@ ecl_file_kw_type * ecl_file_kw_alloc_copy( const ecl_file_kw_type * src ) {
 
 
 
+/**
+   Will write the header information of the file_kw instance, i.e.
+   name, type, size and offset, to a binary stream; the keyword data
+   itself is not written. Used to store a persistent index of an
+   ecl_file, the file_kw instance can be recreated with
+   ecl_file_kw_fread_alloc().
+*/
+
+void ecl_file_kw_fwrite( const ecl_file_kw_type * file_kw , FILE * stream ) {
+  util_fwrite_string( file_kw->header , stream );
+  util_fwrite_int( ecl_type_get_type( file_kw->data_type ) , stream );
+  util_fwrite_int( file_kw->kw_size , stream );
+  util_fwrite( &file_kw->file_offset , sizeof file_kw->file_offset , 1 , stream , __func__ );
+}
+
+
+ecl_file_kw_type * ecl_file_kw_fread_alloc( FILE * stream ) {
+  ecl_file_kw_type * file_kw;
+  char * header = util_fread_alloc_string( stream );
+  ecl_type_enum type = util_fread_int( stream );
+  int kw_size = util_fread_int( stream );
+  offset_type offset;
+
+  util_fread( &offset , sizeof offset , 1 , stream , __func__ );
+  file_kw = ecl_file_kw_alloc__( header , ecl_type_create_from_type( type ) , kw_size , offset );
+  free( header );
+
+  return file_kw;
+}
+
+
 void ecl_file_kw_free( ecl_file_kw_type * file_kw ) {
   if (file_kw->kw != NULL) {
     ecl_kw_free( file_kw->kw );
@@ -223,9 +256,16 @@ static void ecl_file_kw_load_kw( ecl_file_kw_type * file_kw , fortio_type * fort
   if (file_kw->kw != NULL)
     ecl_file_kw_drop_kw( file_kw , inv_map );
 
-  {
+  if (fortio_is_mmapped( fortio )) {
+    file_kw->kw = ecl_kw_mmap_alloc( fortio , file_kw->file_offset );
+    if (file_kw->kw == NULL)
+      util_abort("%s: failed to load keyword:%s from mapped file:%s \n",__func__ , file_kw->header , fortio_filename_ref( fortio ));
+  } else {
     fortio_fseek( fortio , file_kw->file_offset , SEEK_SET );
     file_kw->kw = ecl_kw_fread_alloc( fortio );
+  }
+
+  {
     ecl_file_kw_assert_kw( file_kw );
     inv_map_add_kw( inv_map , file_kw , file_kw->kw );
   }
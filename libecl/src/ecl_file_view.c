@@ -147,11 +147,24 @@ void ecl_file_view_add_flag( ecl_file_view_type * file_view , int flag)  {
 }
 
 
+/*
+  When the file has been memory mapped the keywords are loaded from
+  the mapping, and there is no need to (re)open the FILE * stream.
+*/
+
+static bool ecl_file_view_assert_stream_open( const ecl_file_view_type * ecl_file_view ) {
+  if (fortio_is_mmapped( ecl_file_view->fortio ))
+    return true;
+  else
+    return fortio_assert_stream_open( ecl_file_view->fortio );
+}
+
+
 ecl_kw_type * ecl_file_view_iget_kw( const ecl_file_view_type * ecl_file_view , int index) {
   ecl_file_kw_type * file_kw = ecl_file_view_iget_file_kw( ecl_file_view , index );
   ecl_kw_type * ecl_kw = ecl_file_kw_get_kw_ptr( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
   if (!ecl_kw) {
-    if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+    if (ecl_file_view_assert_stream_open( ecl_file_view )) {
 
       ecl_kw = ecl_file_kw_get_kw( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
 
@@ -225,7 +238,7 @@ ecl_kw_type * ecl_file_view_iget_named_kw( const ecl_file_view_type * ecl_file_v
   ecl_file_kw_type * file_kw = ecl_file_view_iget_named_file_kw( ecl_file_view , kw , ith);
   ecl_kw_type * ecl_kw = ecl_file_kw_get_kw_ptr( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map );
   if (!ecl_kw) {
-    if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+    if (ecl_file_view_assert_stream_open( ecl_file_view )) {
 
       ecl_kw = ecl_file_kw_get_kw( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
 
@@ -274,7 +287,7 @@ void ecl_file_view_replace_kw( ecl_file_view_type * ecl_file_view , ecl_kw_type
 bool ecl_file_view_load_all( ecl_file_view_type * ecl_file_view ) {
   bool loadOK = false;
 
-  if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+  if (ecl_file_view_assert_stream_open( ecl_file_view )) {
     int index;
     for (index = 0; index < vector_get_size( ecl_file_view->kw_list); index++) {
       ecl_file_kw_type * ikw = vector_iget( ecl_file_view->kw_list , index );
@@ -0,0 +1,298 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_fscanf.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include <ert/ecl/ecl_fscanf.h>
+
+
+/*
+  This file implements the number parsing used when reading formatted
+  ECLIPSE files (FUNRST, FEGRID, ...) and GRDECL files. Reading these
+  files with one fscanf() call per element is very slow; here the
+  input is split in whitespace separated tokens with getc() and the
+  numbers are converted by hand. The conversion does not depend on the
+  locale, and it accepts both 'E' and 'D' as exponent character.
+
+  The parse functions work like strtol() and return a pointer to the
+  first character after the number, or NULL if no number could be
+  parsed; i.e. like sscanf() a number prefix of the token is
+  accepted.
+*/
+
+
+#define ECL_FSCANF_MAX_EXACT_DIGITS  15
+#define ECL_FSCANF_MAX_EXACT_POW10   22
+#define ECL_FSCANF_MAX_DIGITS        19
+
+static const double pow10_table[] = {1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 , 1e8 , 1e9 , 1e10 ,
+                                     1e11 , 1e12 , 1e13 , 1e14 , 1e15 , 1e16 , 1e17 , 1e18 , 1e19 , 1e20 ,
+                                     1e21 , 1e22};
+
+
+static bool ecl_fscanf_isspace( int c ) {
+  return (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f');
+}
+
+
+static bool ecl_fscanf_isdigit( int c ) {
+  return (c >= '0' && c <= '9');
+}
+
+
+/**
+   Will skip whitespace and then read one token of at most
+   @max_length characters into @buffer, which must have room for
+   @max_length + 1 characters. The character terminating the token is
+   pushed back to the stream, i.e. the stream is left at the same
+   position as after fscanf(stream , "%<max_length>s" , buffer).
+   Returns false if the end of the file is reached before a token is
+   found.
+*/
+
+bool ecl_fscanf_token( FILE * stream , char * buffer , int max_length) {
+  int length = 0;
+  int c;
+
+  do {
+    c = getc( stream );
+  } while (ecl_fscanf_isspace( c ));
+
+  while ((c != EOF) && !ecl_fscanf_isspace( c )) {
+    buffer[length] = c;
+    length++;
+    if (length == max_length)
+      break;
+    c = getc( stream );
+  }
+
+  if ((c != EOF) && (length < max_length))
+    ungetc( c , stream );
+
+  buffer[length] = '\0';
+  return (length > 0);
+}
+
+
+const char * ecl_fscanf_parse_int( const char * s , int * value ) {
+  const char * p = s;
+  bool negative = false;
+  long long_value = 0;
+
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    p++;
+  }
+
+  if (!ecl_fscanf_isdigit( *p ))
+    return NULL;
+
+  while (ecl_fscanf_isdigit( *p )) {
+    long_value = 10 * long_value + (*p - '0');
+    p++;
+  }
+
+  *value = (int) (negative ? -long_value : long_value);
+  return p;
+}
+
+
+/*
+  Numbers with at most 15 significant digits and a decimal exponent of
+  at most 22 in absolute value can be converted exactly with one
+  multiplication or division, since both the mantissa and the power of
+  ten are exactly representable as double. That covers all numbers
+  written by ECLIPSE; other numbers are passed on to strtod().
+*/
+
+static double ecl_fscanf_strtod( const char * s , int length ) {
+  char * tmp = malloc( length + 1 );
+  double value;
+  int i;
+
+  for (i = 0; i < length; i++)
+    tmp[i] = (s[i] == 'D' || s[i] == 'd') ? 'E' : s[i];
+  tmp[length] = '\0';
+
+  value = strtod( tmp , NULL );
+  free( tmp );
+  return value;
+}
+
+
+const char * ecl_fscanf_parse_double( const char * s , double * value ) {
+  const char * p = s;
+  bool negative = false;
+  bool has_digits = false;
+  uint64_t mantissa = 0;
+  int num_digits = 0;
+  int exp10 = 0;
+
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    p++;
+  }
+
+  while (*p == '0') {
+    has_digits = true;
+    p++;
+  }
+
+  while (ecl_fscanf_isdigit( *p )) {
+    if (num_digits < ECL_FSCANF_MAX_DIGITS)
+      mantissa = 10 * mantissa + (*p - '0');
+    else
+      exp10++;
+    num_digits++;
+    has_digits = true;
+    p++;
+  }
+
+  if (*p == '.') {
+    p++;
+    if (num_digits == 0) {
+      while (*p == '0') {
+        has_digits = true;
+        exp10--;
+        p++;
+      }
+    }
+
+    while (ecl_fscanf_isdigit( *p )) {
+      if (num_digits < ECL_FSCANF_MAX_DIGITS) {
+        mantissa = 10 * mantissa + (*p - '0');
+        exp10--;
+      }
+      num_digits++;
+      has_digits = true;
+      p++;
+    }
+  }
+
+  if (!has_digits)
+    return NULL;
+
+  if (*p == 'E' || *p == 'e' || *p == 'D' || *p == 'd') {
+    const char * exp_start = p;
+    bool exp_negative = false;
+    int exp_value = 0;
+
+    p++;
+    if (*p == '-' || *p == '+') {
+      exp_negative = (*p == '-');
+      p++;
+    }
+
+    if (ecl_fscanf_isdigit( *p )) {
+      while (ecl_fscanf_isdigit( *p )) {
+        if (exp_value < 100000)
+          exp_value = 10 * exp_value + (*p - '0');
+        p++;
+      }
+      exp10 += exp_negative ? -exp_value : exp_value;
+    } else
+      p = exp_start;   /* Not an exponent after all - like strtod() we stop before the 'E'. */
+  }
+
+  if (mantissa == 0)
+    *value = 0;
+  else if ((num_digits <= ECL_FSCANF_MAX_EXACT_DIGITS) && (abs( exp10 ) <= ECL_FSCANF_MAX_EXACT_POW10)) {
+    if (exp10 < 0)
+      *value = mantissa / pow10_table[ -exp10 ];
+    else
+      *value = mantissa * pow10_table[ exp10 ];
+  } else {
+    *value = fabs( ecl_fscanf_strtod( s , p - s ));
+  }
+
+  if (negative)
+    *value = -*value;
+
+  return p;
+}
+
+
+/**
+   Checks whether the token @s starts with the 'N*' repeat syntax used
+   in GRDECL files, i.e. '10000*0.15'. If so the repeat count is
+   stored in @multiplier and a pointer to the value following the '*'
+   is returned; otherwise the function returns NULL. Observe that no
+   spaces are allowed around the '*'.
+*/
+
+const char * ecl_fscanf_parse_repeat( const char * s , int * multiplier ) {
+  int count;
+  const char * p = ecl_fscanf_parse_int( s , &count );
+  if (p && (*p == '*')) {
+    *multiplier = count;
+    return p + 1;
+  } else
+    return NULL;
+}
+
+
+/**
+   Formats @x in the ECLIPSE formatted style 0.ddddE+XX, with @digits
+   digits after the decimal point and @exp_char as the exponent
+   character, into @buffer; returns the number of characters
+   written. The output is equivalent to:
+
+      printf("%<digits+3>.<digits>f%c%+03d" , arg , exp_char , power)
+
+   with 0.1 <= |arg| < 1, but it is formatted with one snprintf("%e")
+   call, without calling log10() and pow() for every element.
+*/
+
+int ecl_fscanf_sprintf_scientific( char * buffer , int digits , char exp_char , double x) {
+  if (x == 0 || !isfinite( x )) {
+    int length = sprintf( buffer , "%*.*f%c%+03d" , digits + 3 , digits , x == 0 ? 0.0 : x , exp_char , 0);
+    return length;
+  } else {
+    char tmp[64];
+    int  power;
+    int  length = 0;
+    int  i;
+    char * exp_ptr;
+
+    /* tmp = "-d.ddddde+XX" */
+    sprintf( tmp , "%.*e" , digits - 1 , x );
+    exp_ptr = strchr( tmp , 'e' );
+    power = atoi( exp_ptr + 1 ) + 1;
+
+    if (x > 0)
+      buffer[length++] = ' ';
+    else
+      buffer[length++] = '-';
+
+    buffer[length++] = '0';
+    buffer[length++] = '.';
+    {
+      const char * digit_ptr = (x > 0) ? tmp : &tmp[1];
+      buffer[length++] = digit_ptr[0];
+      for (i = 2; &digit_ptr[i] < exp_ptr; i++)
+        buffer[length++] = digit_ptr[i];
+    }
+    length += sprintf( &buffer[length] , "%c%+03d" , exp_char , power );
+    return length;
+  }
+}
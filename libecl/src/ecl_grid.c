@@ -716,18 +716,24 @@ typedef struct ecl_cell_struct           ecl_cell_type;
 #define METER_TO_FEET_SCALE_FACTOR   3.28084
 #define METER_TO_CM_SCALE_FACTOR   100.0
 
+/*
+  The cell center and volume are not stored in the cell; they are
+  cached in the contiguous center_x, center_y, center_z and
+  cell_volume columns of the grid, whether they have been calculated
+  is handled by the cell_flags. The fields are ordered to avoid
+  padding.
+*/
+
 struct ecl_cell_struct {
-  point_type center;
   point_type corner_list[8];
 
-  double                 volume;             /* Cache volume - whether it is initialized or not is handled by a cell_flags. */
+  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
+  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
   int                    active;
   int                    active_index[2];    /* [0]: The active matrix index; [1]: the active fracture index */
-  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
   int                    host_cell;          /* the global index of the host cell for an lgr cell, set to -1 for normal cells. */
   int                    coarse_group;       /* The index of the coarse group holding this cell -1 for non-coarsened cells. */
-  int                    cell_flags;
-  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
+  unsigned char          cell_flags;
 };
 
 
@@ -738,6 +744,23 @@ static const float * ecl_grid_get_mapaxes( const ecl_grid_type * grid );
 
 #define ECL_GRID_ID       991010
 
+/*
+  Uniform bucket index over the axis aligned bounding boxes of the
+  cells, used to locate the cell containing a point (x,y,z). The
+  buckets are stored in compressed form: the cells overlapping bucket
+  'b' are found in cell_list[ bucket_offset[b] ... bucket_offset[b+1] ),
+  sorted in increasing global index.
+*/
+
+typedef struct {
+  int      dims[3];
+  double   min[3];
+  double   max[3];
+  double   bucket_size[3];
+  int    * bucket_offset;   /* dims[0]*dims[1]*dims[2] + 1 elements. */
+  int    * cell_list;
+} ecl_grid_xyz_index_type;
+
 struct ecl_grid_struct {
   UTIL_TYPE_ID_DECLARATION;
   int                   lgr_nr;        /* EGRID files: corresponds to item 4 in gridhead - 0 for the main grid.
@@ -748,6 +771,7 @@ struct ecl_grid_struct {
   int                   total_active;
   int                   total_active_fracture;
   bool                * visited;                /* internal helper struct used when searching for index - can be NULL. */
+  ecl_grid_xyz_index_type * xyz_index;          /* bucket index used to locate (x,y,z) points - can be NULL. */
   int                 * index_map;              /* this a list of nx*ny*nz elements, where value -1 means inactive cell .*/
   int                 * inv_index_map;          /* this is list of total_active elements - which point back to the index_map. */
 
@@ -755,6 +779,10 @@ struct ecl_grid_struct {
   int                 * inv_fracture_index_map; /* For fractures: this is list of total_active elements - which point back to the index_map. */
 
   ecl_cell_type      *  cells;
+  double              * center_x;               /* Cached cell centers and volumes - see the comment above */
+  double              * center_y;               /* struct ecl_cell_struct. */
+  double              * center_z;
+  double              * cell_volume;
 
   char                * parent_name;   /* the name of the parent for a nested lgr - for the main grid, and also a
                                           lgr descending directly from the main grid this will be NULL. */
@@ -836,14 +864,17 @@ static void ecl_cell_dump( const ecl_cell_type * cell , FILE * stream) {
 }
 
 
-static void ecl_cell_assert_center( ecl_cell_type * cell);
+static void ecl_grid_assert_center( const ecl_grid_type * grid , int global_index );
 
-static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k , FILE * stream , const double * offset) {
+static void ecl_cell_dump_ascii( const ecl_grid_type * grid , int global_index , int i , int j , int k , FILE * stream , const double * offset) {
+  const ecl_cell_type * cell = &grid->cells[ global_index ];
+  point_type center;
   fprintf(stream , "Cell: i:%3d  j:%3d    k:%3d   host_cell:%d  CoarseGroup:%4d active_nr:%6d  active:%d \nCorners:\n",i,j,k,cell->host_cell, cell->coarse_group , cell->active_index[MATRIX_INDEX], cell->active);
 
-  ecl_cell_assert_center( cell );
+  ecl_grid_assert_center( grid , global_index );
+  point_set( &center , grid->center_x[ global_index ] , grid->center_y[ global_index ] , grid->center_z[ global_index ]);
   fprintf(stream , "Center   : ");
-  point_dump_ascii( &cell->center , stream , offset);
+  point_dump_ascii( &center , stream , offset);
   fprintf(stream , "\n");
 
   {
@@ -1128,23 +1159,29 @@ static int ecl_cell_get_tetrahedron_method( int i , int j , int k) {
 #undef mod
 */
 
-static void ecl_cell_set_center( ecl_cell_type * cell) {
-  point_set(&cell->center , 0 , 0 , 0);
+static void ecl_grid_set_center( const ecl_grid_type * grid , int global_index ) {
+  ecl_cell_type * cell = &grid->cells[ global_index ];
+  point_type center;
+  point_set(&center , 0 , 0 , 0);
   {
     int c;
     for (c = 0; c < 8; c++)
-      point_inplace_add(&cell->center , &cell->corner_list[c]);
+      point_inplace_add(&center , &cell->corner_list[c]);
   }
-  point_inplace_scale(&cell->center , 1.0 / 8.0);
+  point_inplace_scale(&center , 1.0 / 8.0);
 
+  grid->center_x[ global_index ] = center.x;
+  grid->center_y[ global_index ] = center.y;
+  grid->center_z[ global_index ] = center.z;
   SET_CELL_FLAG( cell , CELL_FLAG_CENTER );
 }
 
 
 
-static void ecl_cell_assert_center( ecl_cell_type * cell) {
+static void ecl_grid_assert_center( const ecl_grid_type * grid , int global_index ) {
+  const ecl_cell_type * cell = &grid->cells[ global_index ];
   if (!GET_CELL_FLAG(cell , CELL_FLAG_CENTER))
-    ecl_cell_set_center( cell );
+    ecl_grid_set_center( grid , global_index );
 }
 
 
@@ -1267,18 +1304,20 @@ static inline double tetrahedron_volume6( tetrahedron_type tet ) {
  * when used in opm-parser and has been optimised significantly. This means
  * inlining several operations, e.g. vector operations, and other tricks.
  */
-static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
+static double ecl_grid_get_signed_volume__( const ecl_grid_type * grid , int global_index ) {
+  ecl_cell_type * cell = &grid->cells[ global_index ];
   if (GET_CELL_FLAG(cell , CELL_FLAG_VOLUME))
-    return cell->volume;
+    return grid->cell_volume[ global_index ];
 
-  ecl_cell_assert_center( cell );
+  ecl_grid_assert_center( grid , global_index );
   {
     /*
      * We make an activation record local copy of the cell's corners for less
      * jumping in memory and better cache performance.
      */
-    point_type center = cell->center;
+    point_type center;
     point_type corners[ 8 ];
+    point_set( &center , grid->center_x[ global_index ] , grid->center_y[ global_index ] , grid->center_z[ global_index ]);
     memcpy( corners, cell->corner_list, sizeof( point_type ) * 8 );
 
     tetrahedron_type tet = { .p0 = center };
@@ -1323,15 +1362,15 @@ static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
      * reverted.
      */
 
-    cell->volume = volume * 0.5;
+    grid->cell_volume[ global_index ] = volume * 0.5;
     SET_CELL_FLAG( cell , CELL_FLAG_VOLUME );
   }
-  return cell->volume;
+  return grid->cell_volume[ global_index ];
 }
 
 
-static double ecl_cell_get_volume( ecl_cell_type * cell ) {
-  return fabs( ecl_cell_get_signed_volume(cell));
+static double ecl_grid_get_volume__( const ecl_grid_type * grid , int global_index ) {
+  return fabs( ecl_grid_get_signed_volume__( grid , global_index ));
 }
 
 
@@ -1514,13 +1553,27 @@ static void ecl_grid_free_cells( ecl_grid_type * grid ) {
       nnc_info_free(cell->nnc_info);
   }
   free( grid->cells );
-
+  util_safe_free( grid->center_x );
+  util_safe_free( grid->center_y );
+  util_safe_free( grid->center_z );
+  util_safe_free( grid->cell_volume );
 }
 
 static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
   grid->cells = malloc(grid->size * sizeof * grid->cells );
-  if (!grid->cells)
+  grid->center_x = malloc(grid->size * sizeof * grid->center_x );
+  grid->center_y = malloc(grid->size * sizeof * grid->center_y );
+  grid->center_z = malloc(grid->size * sizeof * grid->center_z );
+  grid->cell_volume = malloc(grid->size * sizeof * grid->cell_volume );
+  if (!(grid->cells && grid->center_x && grid->center_y && grid->center_z && grid->cell_volume)) {
+    util_safe_free( grid->cells );
+    util_safe_free( grid->center_x );
+    util_safe_free( grid->center_y );
+    util_safe_free( grid->center_z );
+    util_safe_free( grid->cell_volume );
+    grid->cells = NULL;
     return false;
+  }
 
   {
     ecl_cell_type * cell0 = ecl_grid_get_cell( grid , 0 );
@@ -1561,6 +1614,7 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
   grid->dualp_flag            = dualp_flag;
   grid->coord_kw              = NULL;
   grid->visited               = NULL;
+  grid->xyz_index             = NULL;
   grid->inv_index_map         = NULL;
   grid->index_map             = NULL;
   grid->fracture_index_map    = NULL;
@@ -3654,11 +3708,11 @@ static bool ecl_grid_compare_cells(const ecl_grid_type * g1 , const ecl_grid_typ
         int i,j,k;
         ecl_grid_get_ijk1( g1 , g , &i , &j , &k);
 
-        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_cell_get_volume( c1 ));
+        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_grid_get_volume__( g1 , g ));
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c1 , i , j , k , stdout , NULL);
+        ecl_cell_dump_ascii( g1 , g , i , j , k , stdout , NULL);
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c2 , i , j , k , stdout , NULL );
+        ecl_cell_dump_ascii( g2 , g , i , j , k , stdout , NULL );
         printf("-----------------------------------------------------------------\n");
 
       }
@@ -3926,7 +3980,7 @@ bool ecl_grid_cell_contains_xyz3( const ecl_grid_type * ecl_grid , int i, int j
   }
 
   // We now check whether the point is strictly inside the cell
-  double signed_volume = ecl_cell_get_signed_volume( cell );
+  double signed_volume = ecl_grid_get_signed_volume__( ecl_grid , ecl_grid_get_global_index3( ecl_grid , i, j , k ));
   if (fabs(signed_volume) <= min_volume)
     return false;
 
@@ -4048,6 +4102,188 @@ static int ecl_grid_get_global_index_from_xyz_around_box(ecl_grid_type * grid ,
 
 
 
+static void ecl_grid_free_xyz_index( ecl_grid_type * grid ) {
+  if (grid->xyz_index != NULL) {
+    free( grid->xyz_index->bucket_offset );
+    free( grid->xyz_index->cell_list );
+    free( grid->xyz_index );
+    grid->xyz_index = NULL;
+  }
+}
+
+
+static int ecl_grid_xyz_index_bucket_coord( const ecl_grid_xyz_index_type * index , int dim , double value ) {
+  int b = (int) floor( (value - index->min[dim]) / index->bucket_size[dim] );
+  return util_int_min( index->dims[dim] - 1 , util_int_max( 0 , b ));
+}
+
+
+static void ecl_grid_xyz_index_cell_range( const ecl_grid_xyz_index_type * index , const ecl_cell_type * cell , int * b1 , int * b2) {
+  b1[0] = ecl_grid_xyz_index_bucket_coord( index , 0 , ecl_cell_min_x( cell ));
+  b1[1] = ecl_grid_xyz_index_bucket_coord( index , 1 , ecl_cell_min_y( cell ));
+  b1[2] = ecl_grid_xyz_index_bucket_coord( index , 2 , ecl_cell_min_z( cell ));
+
+  b2[0] = ecl_grid_xyz_index_bucket_coord( index , 0 , ecl_cell_max_x( cell ));
+  b2[1] = ecl_grid_xyz_index_bucket_coord( index , 1 , ecl_cell_max_y( cell ));
+  b2[2] = ecl_grid_xyz_index_bucket_coord( index , 2 , ecl_cell_max_z( cell ));
+}
+
+
+/**
+   Will build a bucket index over the bounding boxes of all cells in
+   the grid; tainted cells are never returned by
+   ecl_grid_cell_contains_xyz3() and are left out of the index. The
+   index is used by ecl_grid_locate_xyz() and, when the start_index
+   shortcuts fail, by ecl_grid_get_global_index_from_xyz().
+
+   The cached cell center and volume which are needed by the point in
+   cell test are evaluated while building the index, so that the
+   subsequent lookups do not modify the grid.
+*/
+
+void ecl_grid_init_xyz_index( ecl_grid_type * grid ) {
+  ecl_grid_xyz_index_type * index = util_malloc( sizeof * index );
+  int num_buckets;
+  int num_cells = 0;
+
+  for (int dim = 0; dim < 3; dim++) {
+    index->min[dim] = 0;
+    index->max[dim] = 0;
+  }
+
+  for (int global_index = 0; global_index < grid->size; global_index++) {
+    ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+    if (GET_CELL_FLAG( cell , CELL_FLAG_TAINTED ))
+      continue;
+
+    ecl_grid_get_signed_volume__( grid , global_index );
+    {
+      double cell_min[3] = { ecl_cell_min_x( cell ) , ecl_cell_min_y( cell ) , ecl_cell_min_z( cell ) };
+      double cell_max[3] = { ecl_cell_max_x( cell ) , ecl_cell_max_y( cell ) , ecl_cell_max_z( cell ) };
+
+      for (int dim = 0; dim < 3; dim++) {
+        if (num_cells == 0 || cell_min[dim] < index->min[dim])
+          index->min[dim] = cell_min[dim];
+
+        if (num_cells == 0 || cell_max[dim] > index->max[dim])
+          index->max[dim] = cell_max[dim];
+      }
+    }
+    num_cells++;
+  }
+
+  /*
+    Roughly 2x2x2 cells per bucket; for rotated grids the x,y extent
+    is not aligned with i,j but the bucket count is still of the right
+    order of magnitude.
+  */
+  index->dims[0] = util_int_max( 1 , grid->nx / 2 );
+  index->dims[1] = util_int_max( 1 , grid->ny / 2 );
+  index->dims[2] = util_int_max( 1 , grid->nz / 2 );
+  for (int dim = 0; dim < 3; dim++) {
+    index->bucket_size[dim] = (index->max[dim] - index->min[dim]) / index->dims[dim];
+    if (index->bucket_size[dim] <= 0)
+      index->bucket_size[dim] = 1;
+  }
+
+  num_buckets = index->dims[0] * index->dims[1] * index->dims[2];
+  index->bucket_offset = util_calloc( num_buckets + 1 , sizeof * index->bucket_offset );
+  for (int b = 0; b <= num_buckets; b++)
+    index->bucket_offset[b] = 0;
+
+  /* First pass: count the number of cells in each bucket. */
+  for (int global_index = 0; global_index < grid->size; global_index++) {
+    const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+    int b1[3], b2[3];
+
+    if (GET_CELL_FLAG( cell , CELL_FLAG_TAINTED ))
+      continue;
+
+    ecl_grid_xyz_index_cell_range( index , cell , b1 , b2 );
+    for (int bz = b1[2]; bz <= b2[2]; bz++)
+      for (int by = b1[1]; by <= b2[1]; by++)
+        for (int bx = b1[0]; bx <= b2[0]; bx++)
+          index->bucket_offset[ 1 + bx + index->dims[0] * (by + index->dims[1] * bz) ]++;
+  }
+
+  for (int b = 0; b < num_buckets; b++)
+    index->bucket_offset[b + 1] += index->bucket_offset[b];
+
+  /*
+    Second pass: fill in the cells. Iterating in increasing global
+    index order guarantees that each bucket list is sorted.
+  */
+  {
+    int * fill_pos = util_calloc( num_buckets , sizeof * fill_pos );
+    memcpy( fill_pos , index->bucket_offset , num_buckets * sizeof * fill_pos );
+    index->cell_list = util_calloc( util_int_max( 1 , index->bucket_offset[ num_buckets ]) , sizeof * index->cell_list );
+
+    for (int global_index = 0; global_index < grid->size; global_index++) {
+      const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+      int b1[3], b2[3];
+
+      if (GET_CELL_FLAG( cell , CELL_FLAG_TAINTED ))
+        continue;
+
+      ecl_grid_xyz_index_cell_range( index , cell , b1 , b2 );
+      for (int bz = b1[2]; bz <= b2[2]; bz++)
+        for (int by = b1[1]; by <= b2[1]; by++)
+          for (int bx = b1[0]; bx <= b2[0]; bx++) {
+            int b = bx + index->dims[0] * (by + index->dims[1] * bz);
+            index->cell_list[ fill_pos[b] ] = global_index;
+            fill_pos[b]++;
+          }
+    }
+    free( fill_pos );
+  }
+
+  ecl_grid_free_xyz_index( grid );
+  grid->xyz_index = index;
+}
+
+
+bool ecl_grid_has_xyz_index( const ecl_grid_type * grid ) {
+  return (grid->xyz_index != NULL);
+}
+
+
+/**
+   Returns the global index of the cell containing the point (x,y,z),
+   or -1 if no such cell exists. If several cells contain the point
+   the lowest global index is returned, i.e. the result is identical
+   to a linear scan with ecl_grid_cell_contains_xyz1().
+
+   The function requires that the index has been built with
+   ecl_grid_init_xyz_index(); it does not modify the grid and can
+   be called concurrently from several threads.
+*/
+
+int ecl_grid_locate_xyz( const ecl_grid_type * grid , double x , double y , double z) {
+  const ecl_grid_xyz_index_type * index = grid->xyz_index;
+  double p[3] = {x , y , z};
+  int bucket[3];
+
+  if (index == NULL)
+    util_abort("%s: must call ecl_grid_init_xyz_index() first \n",__func__);
+
+  for (int dim = 0; dim < 3; dim++) {
+    if (p[dim] < index->min[dim] || p[dim] > index->max[dim])
+      return -1;
+    bucket[dim] = ecl_grid_xyz_index_bucket_coord( index , dim , p[dim] );
+  }
+
+  {
+    int b = bucket[0] + index->dims[0] * (bucket[1] + index->dims[1] * bucket[2]);
+    for (int pos = index->bucket_offset[b]; pos < index->bucket_offset[b + 1]; pos++) {
+      int global_index = index->cell_list[pos];
+      if (ecl_grid_cell_contains_xyz1( grid , global_index , x , y , z))
+        return global_index;
+    }
+  }
+  return -1;
+}
+
+
 /**
    This function will find the global index of the cell containing the
    world coordinates (x,y,z), if no cell can be found the function
@@ -4095,16 +4331,14 @@ int ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double
   }
 
   /*
-    OK - the attempted shortcuts did not pay off. Perform full linear search.
+    OK - the attempted shortcuts did not pay off. Fall back to the
+    bucket index; this returns the same cell as a full linear search
+    would have done.
   */
+  if (grid->xyz_index == NULL)
+    ecl_grid_init_xyz_index( grid );
 
-  global_index = -1;
-
-  for (int index = 0; index < grid->size; index++) {
-    if (ecl_grid_cell_contains_xyz1( grid , index , x , y , z))
-      return index;
-  }
-  return -1;
+  return ecl_grid_locate_xyz( grid , x , y , z );
 }
 
 bool ecl_grid_get_ijk_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index, int *i, int *j, int *k ) {
@@ -4288,6 +4522,7 @@ void ecl_grid_free(ecl_grid_type * grid) {
   hash_free( grid->children );
   util_safe_free( grid->parent_name );
   util_safe_free( grid->visited );
+  ecl_grid_free_xyz_index( grid );
   util_safe_free( grid->name );
   free( grid );
 }
@@ -4302,15 +4537,12 @@ void ecl_grid_free__( void * arg ) {
 
 
 void ecl_grid_get_distance(const ecl_grid_type * grid , int global_index1, int global_index2 , double *dx , double *dy , double *dz) {
-  ecl_cell_type * cell1 = ecl_grid_get_cell( grid , global_index1);
-  ecl_cell_type * cell2 = ecl_grid_get_cell( grid , global_index2);
-
-  ecl_cell_assert_center( cell1 );
-  ecl_cell_assert_center( cell2 );
+  ecl_grid_assert_center( grid , global_index1 );
+  ecl_grid_assert_center( grid , global_index2 );
   {
-    *dx = cell1->center.x - cell2->center.x;
-    *dy = cell1->center.y - cell2->center.y;
-    *dz = cell1->center.z - cell2->center.z;
+    *dx = grid->center_x[ global_index1 ] - grid->center_x[ global_index2 ];
+    *dy = grid->center_y[ global_index1 ] - grid->center_y[ global_index2 ];
+    *dz = grid->center_z[ global_index1 ] - grid->center_z[ global_index2 ];
   }
 }
 
@@ -4520,12 +4752,11 @@ void ecl_grid_get_ijk1A(const ecl_grid_type *ecl_grid , int active_index , int *
 
 
 void ecl_grid_get_xyz1(const ecl_grid_type * grid , int global_index , double *xpos , double *ypos , double *zpos) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
+  ecl_grid_assert_center( grid , global_index );
   {
-    *xpos = cell->center.x;
-    *ypos = cell->center.y;
-    *zpos = cell->center.z;
+    *xpos = grid->center_x[ global_index ];
+    *ypos = grid->center_y[ global_index ];
+    *zpos = grid->center_z[ global_index ];
   }
 }
 
@@ -4604,9 +4835,8 @@ void ecl_grid_get_xyz1A(const ecl_grid_type * grid , int active_index , double *
 
 
 double ecl_grid_get_cdepth1(const ecl_grid_type * grid , int global_index) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
-  return cell->center.z;
+  ecl_grid_assert_center( grid , global_index );
+  return grid->center_z[ global_index ];
 }
 
 
@@ -5154,10 +5384,7 @@ int ecl_grid_get_cell_twist3(const ecl_grid_type * ecl_grid, int i, int j , int
 
 
 double ecl_grid_get_cell_volume1( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  int i,j,k;
-  ecl_grid_get_ijk1( ecl_grid , global_index, &i , &j , &k);
-  return ecl_cell_get_volume( cell );
+  return ecl_grid_get_volume__( ecl_grid , global_index );
 }
 
 
@@ -5574,7 +5801,7 @@ static void ecl_grid_dump_ascii__(ecl_grid_type * grid , bool active_only , FILE
       if (cell->active_index[MATRIX_INDEX] >= 0 || !active_only) {
         int i,j,k;
         ecl_grid_get_ijk1( grid , l , &i , &j , &k);
-        ecl_cell_dump_ascii( cell , i,j,k , stream , NULL);
+        ecl_cell_dump_ascii( grid , l , i,j,k , stream , NULL);
       }
     }
   }
@@ -5610,17 +5837,15 @@ void ecl_grid_dump_ascii(ecl_grid_type * grid , bool active_only , FILE * stream
 
 
 void ecl_grid_dump_ascii_cell1(ecl_grid_type * grid , int global_index , FILE * stream , const double * offset) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
   int i,j,k;
   ecl_grid_get_ijk1( grid , global_index , &i , &j , &k);
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_cell_dump_ascii(grid , global_index , i,j,k, stream , offset);
 }
 
 
 void ecl_grid_dump_ascii_cell3(ecl_grid_type * grid , int i , int j , int k , FILE * stream , const double * offset) {
   int global_index  = ecl_grid_get_global_index3(grid , i,j,k);
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_cell_dump_ascii(grid , global_index , i,j,k, stream , offset);
 }
 
 /*****************************************************************/
@@ -6620,6 +6845,57 @@ void ecl_grid_ri_export( const ecl_grid_type * ecl_grid , double * ri_points) {
     ecl_grid_cell_ri_export( ecl_grid , global_index , ri_points );
 }
 
+
+/*
+  The ecl_grid_export_xxx() functions fill caller allocated arrays
+  with one element for each active cell, ordered by active index. The
+  arrays must have room for ecl_grid_get_active_size() elements; for
+  the functions taking several arrays any of them can be NULL.
+*/
+
+void ecl_grid_export_index( const ecl_grid_type * grid , int * global_index , int * i , int * j , int * k) {
+  for (int active_index = 0; active_index < grid->total_active; active_index++) {
+    int g = grid->inv_index_map[ active_index ];
+    int ii,jj,kk;
+
+    ecl_grid_get_ijk1( grid , g , &ii , &jj , &kk );
+    if (global_index)
+      global_index[ active_index ] = g;
+
+    if (i)
+      i[ active_index ] = ii;
+
+    if (j)
+      j[ active_index ] = jj;
+
+    if (k)
+      k[ active_index ] = kk;
+  }
+}
+
+
+void ecl_grid_export_volume( const ecl_grid_type * grid , double * volume ) {
+  for (int active_index = 0; active_index < grid->total_active; active_index++)
+    volume[ active_index ] = ecl_grid_get_volume__( grid , grid->inv_index_map[ active_index ] );
+}
+
+
+void ecl_grid_export_position( const ecl_grid_type * grid , double * x , double * y , double * z) {
+  for (int active_index = 0; active_index < grid->total_active; active_index++) {
+    int g = grid->inv_index_map[ active_index ];
+    ecl_grid_assert_center( grid , g );
+
+    if (x)
+      x[ active_index ] = grid->center_x[ g ];
+
+    if (y)
+      y[ active_index ] = grid->center_y[ g ];
+
+    if (z)
+      z[ active_index ] = grid->center_z[ g ];
+  }
+}
+
 /*****************************************************************/
 
 
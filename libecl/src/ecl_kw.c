@@ -30,6 +30,7 @@
 #include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_type.h>
+#include <ert/ecl/ecl_fscanf.h>
 
 
 #define ECL_KW_TYPE_ID  6111098
@@ -97,14 +98,16 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 /* Format string used when reading and writing formatted
    files. Observe the following about these format strings:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
+    1. Numerical values (int, float and double) are not read with
+       these format strings, but with the token parser in
+       ecl_fscanf.c; that parser also handles the 'D' exponent of
+       doubles.
 
     2. For both double and float the write format contains two '%'
        characters - that is because the values are split in a prefix
-       and a power prior to writing - see the function
-       __fprintf_scientific().
+       and a power prior to writing. The values are written with
+       ecl_fscanf_sprintf_scientific(), the WRITE_DIGITS_XXX defines
+       must be kept in sync with the format strings.
 
     3. The logical type involves converting back and forth between 'T'
        and 'F' and internal logical representation. The format strings
@@ -129,6 +132,9 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 #define WRITE_FMT_MESS    "%s"
 #define WRITE_FMT_BOOL    "  %c"
 
+#define WRITE_DIGITS_FLOAT    8
+#define WRITE_DIGITS_DOUBLE  14
+
 
 /*****************************************************************/
 /* The boolean type is not a native type which can be uniquely
@@ -1053,22 +1059,56 @@ static bool ecl_kw_fscanf_qstring(char *s , const char *fmt , int len, FILE *str
 
 
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  Reads the int, float and double data of a formatted keyword with
+  the token parser from ecl_fscanf.c. The 'N*value' repeat syntax is
+  accepted, although ECLIPSE itself does not write it in formatted
+  files.
 */
-/** Should be: NESTED */
-
-static double __fscanf_ECL_double( FILE * stream , const char * fmt) {
-  int    read_count , power;
-  double value , arg;
-  read_count = fscanf( stream , fmt , &arg , &power);
-  if (read_count == 2)
-    value = arg * pow(10 , power );
-  else {
-    util_abort("%s: read failed \n",__func__);
-    value = -1;
+
+#define ECL_KW_MAX_TOKEN_LENGTH 64
+
+static void ecl_kw_fscanf_numeric_data( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
+  FILE * stream = fortio_get_FILE( fortio );
+  char token[ECL_KW_MAX_TOKEN_LENGTH + 1];
+  int index = 0;
+
+  while (index < ecl_kw->size) {
+    const char * value_string = token;
+    const char * end_ptr;
+    int multiplier = 1;
+    int int_value = 0;
+    double double_value = 0;
+
+    if (!ecl_fscanf_token( stream , token , ECL_KW_MAX_TOKEN_LENGTH ))
+      util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , index , ecl_kw->header8 , fortio_filename_ref(fortio));
+
+    {
+      const char * repeat_value = ecl_fscanf_parse_repeat( token , &multiplier );
+      if (repeat_value)
+        value_string = repeat_value;
+    }
+
+    if (ecl_type_is_int( ecl_kw->data_type ))
+      end_ptr = ecl_fscanf_parse_int( value_string , &int_value );
+    else
+      end_ptr = ecl_fscanf_parse_double( value_string , &double_value );
+
+    if ((end_ptr == NULL) || (*end_ptr != '\0') || (multiplier < 1) || (index + multiplier > ecl_kw->size))
+      util_abort("%s: invalid value:\"%s\" after reading %d values of keyword:%s from:%s - aborting \n",__func__ , token , index , ecl_kw->header8 , fortio_filename_ref(fortio));
+
+    {
+      int i;
+      for (i = 0; i < multiplier; i++) {
+        if (ecl_type_is_int( ecl_kw->data_type ))
+          ((int *) ecl_kw->data)[index] = int_value;
+        else if (ecl_type_is_float( ecl_kw->data_type ))
+          ((float *) ecl_kw->data)[index] = double_value;
+        else
+          ((double *) ecl_kw->data)[index] = double_value;
+        index++;
+      }
+    }
   }
-  return value;
 }
 
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
@@ -1077,65 +1117,45 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
   if (ecl_kw->size > 0) {
     const int blocksize = get_blocksize( ecl_kw->data_type );
     if (fmt_file) {
-      const int blocks      = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-      const char * read_fmt = get_read_fmt( ecl_kw->data_type );
-      FILE * stream         = fortio_get_FILE(fortio);
-      int    offset         = 0;
-      int    index          = 0;
-      int    ib,ir;
-      for (ib = 0; ib < blocks; ib++) {
-        int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
-        for (ir = 0; ir < read_elm; ir++) {
-          switch(ecl_kw_get_type(ecl_kw)) {
-          case(ECL_CHAR_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8, stream);
-            break;
-          case(ECL_INT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (int *) &ecl_kw->data[offset]);
-              if (iread != 1)
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , offset / ecl_kw_get_sizeof_ctype(ecl_kw) , ecl_kw->header8 , fortio_filename_ref(fortio));
-            }
-            break;
-          case(ECL_FLOAT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (float *) &ecl_kw->data[offset]);
-              if (iread != 1) {
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ ,
-                           offset / ecl_kw_get_sizeof_ctype(ecl_kw) ,
-                           ecl_kw->header8 ,
-                           fortio_filename_ref(fortio));
+      if (ecl_type_is_int(ecl_kw->data_type) || ecl_type_is_float(ecl_kw->data_type) || ecl_type_is_double(ecl_kw->data_type))
+        ecl_kw_fscanf_numeric_data( ecl_kw , fortio );
+      else {
+        const int blocks      = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+        const char * read_fmt = get_read_fmt( ecl_kw->data_type );
+        FILE * stream         = fortio_get_FILE(fortio);
+        int    offset         = 0;
+        int    index          = 0;
+        int    ib,ir;
+        for (ib = 0; ib < blocks; ib++) {
+          int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
+          for (ir = 0; ir < read_elm; ir++) {
+            switch(ecl_kw_get_type(ecl_kw)) {
+            case(ECL_CHAR_TYPE):
+              ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8, stream);
+              break;
+            case(ECL_BOOL_TYPE):
+              {
+                char bool_char;
+                if (fscanf(stream , read_fmt , &bool_char) == 1) {
+                  if (bool_char == BOOL_TRUE_CHAR)
+                    ecl_kw_iset_bool(ecl_kw , index , true);
+                  else if (bool_char == BOOL_FALSE_CHAR)
+                    ecl_kw_iset_bool(ecl_kw , index , false);
+                  else
+                    util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
+                } else
+                  util_abort("%s: read failed - premature file end? \n",__func__ );
               }
+              break;
+            case(ECL_MESS_TYPE):
+              ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8 , stream);
+              break;
+            default:
+              util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw_get_type(ecl_kw));
             }
-            break;
-          case(ECL_DOUBLE_TYPE):
-            {
-              double value = __fscanf_ECL_double( stream , read_fmt );
-              ecl_kw_iset(ecl_kw , index , &value);
-            }
-            break;
-          case(ECL_BOOL_TYPE):
-            {
-              char bool_char;
-              if (fscanf(stream , read_fmt , &bool_char) == 1) {
-                if (bool_char == BOOL_TRUE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , true);
-                else if (bool_char == BOOL_FALSE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , false);
-                else
-                  util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
-              } else
-                util_abort("%s: read failed - premature file end? \n",__func__ );
-            }
-            break;
-          case(ECL_MESS_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8 , stream);
-            break;
-          default:
-            util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw_get_type(ecl_kw));
+            offset += ecl_kw_get_sizeof_ctype(ecl_kw);
+            index++;
           }
-          offset += ecl_kw_get_sizeof_ctype(ecl_kw);
-          index++;
         }
       }
 
@@ -1174,12 +1194,18 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
         }
       } else {
         /**
-           This function handles the fuc***g blocks transparently at a
-           low level.
+           The fast path reads the complete payload in one go and
+           strips the record markers and endian flips in the same
+           pass; if the file does not have the standard block layout
+           we fall back to fortio_fread_buffer() which handles the
+           fuc***g blocks transparently at a low level.
         */
-        read_ok = fortio_fread_buffer(fortio , ecl_kw->data , ecl_kw->size * ecl_kw_get_sizeof_ctype(ecl_kw));
-        if (read_ok && ECL_ENDIAN_FLIP)
-          ecl_kw_endian_convert_data(ecl_kw);
+        read_ok = fortio_fread_blocks(fortio , ecl_kw->data , ecl_kw_get_sizeof_ctype(ecl_kw) , ecl_kw->size , blocksize , ECL_ENDIAN_FLIP);
+        if (!read_ok) {
+          read_ok = fortio_fread_buffer(fortio , ecl_kw->data , ecl_kw->size * ecl_kw_get_sizeof_ctype(ecl_kw));
+          if (read_ok && ECL_ENDIAN_FLIP)
+            ecl_kw_endian_convert_data(ecl_kw);
+        }
       }
       return read_ok;
     }
@@ -1189,6 +1215,22 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
 }
 
 
+/*
+  Will return the file offset of element @index in an unformatted
+  keyword where the header starts at @kw_offset; this can be used to
+  read individual elements directly from the file without going
+  through a fortio instance.
+*/
+
+offset_type ecl_kw_unformatted_element_offset( offset_type kw_offset , ecl_data_type data_type , int index ) {
+  int element_size = ecl_type_get_sizeof_ctype( data_type );
+  if (ecl_type_is_char( data_type ) || ecl_type_is_mess( data_type ))
+    element_size = ECL_STRING8_LENGTH;
+
+  return fortio_data_element_offset( kw_offset + ECL_KW_HEADER_FORTIO_SIZE , index , element_size , get_blocksize( data_type ));
+}
+
+
 void ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ecl_data_type data_type, int element_count, const int_vector_type* index_map, char* buffer) {
     const int block_size = get_blocksize(data_type);
     FILE *stream  = fortio_get_FILE( fortio );
@@ -1261,6 +1303,167 @@ bool ecl_kw_fskip_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
 }
 
 
+/*****************************************************************/
+/*
+  The ecl_kw_mmap_xxx() functions are the equivalents of the
+  ecl_kw_fread_xxx() functions for a fortio instance which has been
+  memory mapped with fortio_mmap(). Instead of reading through the
+  FILE * stream the keyword is assembled directly from the mapped
+  region, i.e. the data passes through memory once; the byte swapping
+  is done block by block while the block is still in the cache.
+
+  The position in the file is passed explicitly with the @offset
+  argument, which is updated to point to the next keyword on success;
+  the shared file position of the fortio instance is not touched. This
+  also means that the functions can be called concurrently from
+  several threads on the same fortio instance.
+
+  Observe that ecl_kw_mmap_header() will return ECL_KW_READ_FAIL for
+  an unrecognized type name, whereas ecl_kw_fread_header() will abort.
+*/
+
+ecl_read_status_enum ecl_kw_mmap_header( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset) {
+  offset_type pos = *offset;
+  int record_size;
+  const char * buffer;
+
+  /* Check the size before fortio_mmap_record() goes looking for the tail marker. */
+  if (fortio_mmap_record_size( fortio , pos ) != ECL_KW_HEADER_DATA_SIZE)
+    return ECL_KW_READ_FAIL;
+
+  buffer = fortio_mmap_record( fortio , &pos , &record_size );
+  if (buffer) {
+    char header[ECL_STRING8_LENGTH + 1];
+    char ecl_type_str[ECL_TYPE_LENGTH + 1];
+    int size;
+
+    memcpy( header , &buffer[0] , ECL_STRING8_LENGTH);
+    memcpy( &size , &buffer[ECL_STRING8_LENGTH] , sizeof size );
+    memcpy( ecl_type_str , &buffer[ECL_STRING8_LENGTH + sizeof(size)] , ECL_TYPE_LENGTH);
+    header[ECL_STRING8_LENGTH] = '\0';
+    ecl_type_str[ECL_TYPE_LENGTH] = '\0';
+
+    if (ECL_ENDIAN_FLIP)
+      util_endian_flip_vector(&size , sizeof size , 1);
+
+    if ((size < 0) || !ecl_type_is_valid_name( ecl_type_str ))
+      return ECL_KW_READ_FAIL;
+
+    {
+      ecl_data_type data_type = ecl_type_create_from_name( ecl_type_str );
+      ecl_kw_initialize( ecl_kw , header , size , data_type);
+      *offset = pos;
+
+      if (ecl_type_is_C010(data_type))
+        return ECL_KW_READ_SKIP;
+
+      return ECL_KW_READ_OK;
+    }
+  } else
+    return ECL_KW_READ_FAIL;
+}
+
+
+bool ecl_kw_mmap_data( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset) {
+  offset_type pos = *offset;
+
+  if (ecl_kw->size > 0) {
+    const size_t sizeof_ctype = ecl_kw_get_sizeof_ctype( ecl_kw );
+
+    if (ecl_type_is_char(ecl_kw->data_type) || ecl_type_is_mess(ecl_kw->data_type)) {
+      const int blocksize = get_blocksize( ecl_kw->data_type );
+      const int blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+      int ib;
+
+      for (ib = 0; ib < blocks; ib++) {
+        int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
+        int record_size;
+        const char * record = fortio_mmap_record( fortio , &pos , &record_size );
+        int ir;
+
+        if (!record || (record_size != read_elm * ECL_STRING8_LENGTH))
+          return false;
+
+        for (ir = 0; ir < read_elm; ir++) {
+          char * target = &ecl_kw->data[(ib * blocksize + ir) * sizeof_ctype];
+          memcpy( target , &record[ir * ECL_STRING8_LENGTH] , ECL_STRING8_LENGTH );
+          target[ECL_STRING8_LENGTH] = '\0';
+        }
+      }
+    } else {
+      const size_t byte_size = ecl_kw->size * sizeof_ctype;
+      size_t bytes_read = 0;
+
+      while (bytes_read < byte_size) {
+        int record_size;
+        const char * record = fortio_mmap_record( fortio , &pos , &record_size );
+
+        if (!record || (bytes_read + record_size > byte_size) || (record_size % sizeof_ctype != 0))
+          return false;
+
+        if (ECL_ENDIAN_FLIP)
+          util_endian_flip_copy( &ecl_kw->data[bytes_read] , record , sizeof_ctype , record_size / sizeof_ctype );
+        else
+          memcpy( &ecl_kw->data[bytes_read] , record , record_size );
+
+        bytes_read += record_size;
+      }
+    }
+  }
+
+  *offset = pos;
+  return true;
+}
+
+
+/*
+  Will skip the data section of a keyword without looking at the
+  content of the mapped region, i.e. scanning the headers of a large
+  file will only touch the pages containing the headers. Returns
+  false if the data section extends beyond the end of the file.
+*/
+
+bool ecl_kw_mmap_skip_data__( ecl_data_type data_type , int element_count , const fortio_type * fortio , offset_type * offset) {
+  if (element_count > 0) {
+    const int blocksize = get_blocksize( data_type );
+    const int block_count = element_count / blocksize + (element_count % blocksize == 0 ? 0 : 1);
+    offset_type element_size = ecl_type_get_sizeof_ctype(data_type);
+    offset_type new_offset;
+
+    if (ecl_type_is_char(data_type))
+      element_size = ECL_STRING8_LENGTH;
+
+    if (ecl_type_is_C010(data_type))
+      element_size = ECL_STRING10_LENGTH;
+
+    new_offset = *offset + block_count * 8 + element_size * element_count;
+    if (new_offset > fortio_mmap_size( fortio ))
+      return false;
+
+    *offset = new_offset;
+  }
+  return true;
+}
+
+
+ecl_kw_type * ecl_kw_mmap_alloc( const fortio_type * fortio , offset_type offset ) {
+  ecl_kw_type * ecl_kw = ecl_kw_alloc_empty();
+  bool OK = false;
+
+  if (ecl_kw_mmap_header( ecl_kw , fortio , &offset ) == ECL_KW_READ_OK) {
+    ecl_kw_alloc_data( ecl_kw );
+    OK = ecl_kw_mmap_data( ecl_kw , fortio , &offset );
+  }
+
+  if (!OK) {
+    ecl_kw_free( ecl_kw );
+    ecl_kw = NULL;
+  }
+
+  return ecl_kw;
+}
+
+
 /**
    This function will skip the header part of an ecl_kw instance. The
    function will read the file content at the current position, it is
@@ -1516,76 +1719,54 @@ void ecl_kw_fskip(fortio_type *fortio) {
 
 
 static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
-  if (ECL_ENDIAN_FLIP)
-    ecl_kw_endian_convert_data(ecl_kw);
-
-  {
-    const int blocksize  = get_blocksize( ecl_kw->data_type );
+  const int blocksize  = get_blocksize( ecl_kw->data_type );
+  if (ecl_type_is_char(ecl_kw->data_type) || ecl_type_is_mess(ecl_kw->data_type)) {
     const int num_blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
     int block_nr;
 
     for (block_nr = 0; block_nr < num_blocks; block_nr++) {
       int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
-      if (ecl_type_is_char(ecl_kw->data_type) || ecl_type_is_mess(ecl_kw->data_type)) {
-        /*
-           Due to the terminating \0 characters there is not a
-           continous file/memory mapping - the \0 characters arel
-           skipped.
-        */
-        FILE *stream      = fortio_get_FILE(fortio);
-        int   record_size = this_blocksize * ECL_STRING8_LENGTH;     /* The total size in bytes of the record written by the fortio layer. */
-        int   i;
-        fortio_init_write(fortio , record_size );
-        for (i = 0; i < this_blocksize; i++)
-          fwrite(&ecl_kw->data[(block_nr * blocksize + i) * ecl_kw_get_sizeof_ctype(ecl_kw)] , 1 , ECL_STRING8_LENGTH , stream);
-        fortio_complete_write(fortio , record_size);
-      } else {
-        int   record_size = this_blocksize * ecl_kw_get_sizeof_ctype(ecl_kw);  /* The total size in bytes of the record written by the fortio layer. */
-        fortio_fwrite_record(fortio , &ecl_kw->data[block_nr * blocksize * ecl_kw_get_sizeof_ctype(ecl_kw)] , record_size);
-      }
+      /*
+         Due to the terminating \0 characters there is not a
+         continous file/memory mapping - the \0 characters arel
+         skipped.
+      */
+      FILE *stream      = fortio_get_FILE(fortio);
+      int   record_size = this_blocksize * ECL_STRING8_LENGTH;     /* The total size in bytes of the record written by the fortio layer. */
+      int   i;
+      fortio_init_write(fortio , record_size );
+      for (i = 0; i < this_blocksize; i++)
+        fwrite(&ecl_kw->data[(block_nr * blocksize + i) * ecl_kw_get_sizeof_ctype(ecl_kw)] , 1 , ECL_STRING8_LENGTH , stream);
+      fortio_complete_write(fortio , record_size);
     }
-  }
-
-  if (ECL_ENDIAN_FLIP)
-    ecl_kw_endian_convert_data(ecl_kw);
+  } else
+    /*
+      The records are assembled, with endian flipping, in a separate
+      buffer and written in one go; the keyword data is not modified.
+    */
+    fortio_fwrite_blocks(fortio , ecl_kw->data , ecl_kw_get_sizeof_ctype(ecl_kw) , ecl_kw->size , blocksize , ECL_ENDIAN_FLIP);
 }
 
 
 
 /**
-     The point of this awkward function is that I have not managed to
-     use C fprintf() syntax to reproduce the ECLIPSE
-     formatting. ECLIPSE expects the following formatting for float
-     and double values:
+     ECLIPSE expects the following formatting for float and double
+     values:
 
         0.ddddddddE+03       (float)
         0.ddddddddddddddD+03 (double)
 
-     The problem with printf have been:
-
-        1. To force the radix part to start with 0.
-        2. To use 'D' as the exponent start for double values.
-
-     If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
-     the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
-     updated accordingly.
-  */
+     which can not be produced directly with a C printf() format; the
+     formatting is done by ecl_fscanf_sprintf_scientific().
+*/
 
-   static void __fprintf_scientific(FILE * stream, const char * fmt , double x) {
-    double pow_x = ceil(log10(fabs(x)));
-    double arg_x   = x / pow(10.0 , pow_x);
-    if (x != 0.0) {
-      if (fabs(arg_x) == 1.0) {
-        arg_x *= 0.10;
-        pow_x += 1;
-      }
-    } else {
-      arg_x = 0.0;
-      pow_x = 0.0;
-    }
-    fprintf(stream , fmt , arg_x , (int) pow_x);
-  }
+static void ecl_kw_fprintf_scientific(FILE * stream, int digits , char exp_char , double x) {
+  char buffer[64];
+  buffer[0] = ' ';
+  buffer[1] = ' ';
+  ecl_fscanf_sprintf_scientific( &buffer[2] , digits , exp_char , x );
+  fputs( buffer , stream );
+}
 
 
 static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
@@ -1634,13 +1815,13 @@ static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * f
           case(ECL_FLOAT_TYPE):
             {
               float float_value = ((float *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , float_value );
+              ecl_kw_fprintf_scientific( stream , WRITE_DIGITS_FLOAT , 'E' , float_value );
             }
             break;
           case(ECL_DOUBLE_TYPE):
             {
               double double_value = ((double *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , double_value );
+              ecl_kw_fprintf_scientific( stream , WRITE_DIGITS_DOUBLE , 'D' , double_value );
             }
             break;
           case(ECL_MESS_TYPE):
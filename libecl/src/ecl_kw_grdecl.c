@@ -24,6 +24,7 @@
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_type.h>
 #include <ert/ecl/ecl_util.h>
+#include <ert/ecl/ecl_fscanf.h>
 
 
 /*
@@ -346,7 +347,7 @@ static char * fscanf_alloc_grdecl_data( const char * header , bool strict , ecl_
   char * data         = util_calloc( sizeof_ctype * data_size , sizeof * data );
 
   while (true) {
-    if (fscanf(stream , "%32s" , buffer) == 1) {
+    if (ecl_fscanf_token( stream , buffer , 32 )) {
       if (strcmp(buffer , ECL_COMMENT_STRING) == 0) {
         // We have read a comment marker - just read up to the end of line.
         char c;
@@ -362,59 +363,44 @@ static char * fscanf_alloc_grdecl_data( const char * header , bool strict , ecl_
       } else if (strcmp(buffer , ECL_DATA_TERMINATION) == 0)
         break;
       else {
-        // We have read a valid input string; scan numerical input values from it.
-        // The multiplier algorithm will fail hard if there are spaces on either side
-        // of the '*'.
+        // We have read a valid input string; parse numerical input values from it
+        // with the hand written parser in ecl_fscanf.c. The multiplier algorithm
+        // will fail hard if there are spaces on either side of the '*'.
 
-        int multiplier;
-        void * value_ptr = NULL;
+        int multiplier = 1;
+        const char * value_string = buffer;
+        const char * end_ptr = NULL;
         bool   char_input = false;
+        int    int_value;
+        float  float_value;
+        double double_value;
+        void * value_ptr = NULL;
 
-        if (ecl_type_is_int(data_type)) {
-          int value;
-
-          if (sscanf(buffer , "%d*%d" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%d" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
-
-          value_ptr = &value;
-        } else if (ecl_type_is_float(data_type)) {
-          float value;
-
-          if (sscanf(buffer , "%d*%g" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%g" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
-
-          value_ptr = &value;
-        } else if (ecl_type_is_double(data_type)) {
-          double value;
-
-          if (sscanf(buffer , "%d*%lg" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%lg" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
+        {
+          const char * repeat_value = ecl_fscanf_parse_repeat( buffer , &multiplier );
+          if (repeat_value)
+            value_string = repeat_value;
+        }
 
-          value_ptr = &value;
+        if (ecl_type_is_int(data_type)) {
+          end_ptr = ecl_fscanf_parse_int( value_string , &int_value );
+          value_ptr = &int_value;
+        } else if (ecl_type_is_float(data_type) || ecl_type_is_double(data_type)) {
+          end_ptr = ecl_fscanf_parse_double( value_string , &double_value );
+          float_value = double_value;
+          if (ecl_type_is_float(data_type))
+            value_ptr = &float_value;
+          else
+            value_ptr = &double_value;
         } else
           util_abort("%s: sorry type:%s not supported \n",__func__ , ecl_type_get_name(data_type));
 
+        if (end_ptr == NULL) {
+          char_input = true;
+          if (strict)
+            util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
+        }
+
         /*
           Removing this warning on user request:
           if (char_input)
@@ -1206,6 +1206,15 @@ ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * k
       util_abort("%s: Sorry the SMSPEC file seems to lack all time information, need either TIME, or DAY/MONTH/YEAR information. Can not proceed.",__func__);
       return NULL;
     }
+
+    /*
+      A smspec instance loaded from file is not modified; the flat
+      lookup indices are frozen so that the (frequent) key lookups
+      are done without locking.
+    */
+    hash_freeze( ecl_smspec->gen_var_index );
+    hash_freeze( ecl_smspec->field_var_index );
+    hash_freeze( ecl_smspec->misc_var_index );
     return ecl_smspec;
   } else {
     /** Failed to load from disk. */
@@ -37,6 +37,7 @@
 #include <ert/ecl/ecl_sum.h>
 #include <ert/ecl/ecl_smspec.h>
 #include <ert/ecl/ecl_sum_data.h>
+#include <ert/ecl/ecl_sum_vector.h>
 #include <ert/ecl/smspec_node.h>
 
 
@@ -167,12 +168,18 @@ static ecl_sum_type * ecl_sum_alloc__( const char * input_arg , const char * key
 }
 
 
-static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type * data_files , bool include_restart) {
+static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type * data_files , bool include_restart , bool lazy_load) {
+  bool load_ok;
   if (ecl_sum->data != NULL)
     ecl_sum_free_data( ecl_sum );
 
   ecl_sum->data = ecl_sum_data_alloc( ecl_sum->smspec );
-  if (ecl_sum_data_fread( ecl_sum->data , data_files )) {
+  if (lazy_load)
+    load_ok = ecl_sum_data_fread_lazy( ecl_sum->data , data_files );
+  else
+    load_ok = ecl_sum_data_fread( ecl_sum->data , data_files );
+
+  if (load_ok) {
     if (include_restart) {
 
     }
@@ -192,7 +199,7 @@ static void ecl_sum_fread_history( ecl_sum_type * ecl_sum ) {
 
 
 
-static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart) {
+static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart , bool lazy_load) {
   ecl_sum->smspec = ecl_smspec_fread_alloc( header_file , ecl_sum->key_join_string , include_restart);
   if (ecl_sum->smspec) {
     bool fmt_file;
@@ -201,7 +208,7 @@ static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , con
   } else
     return false;
 
-  if (ecl_sum_fread_data( ecl_sum , data_files , include_restart )) {
+  if (ecl_sum_fread_data( ecl_sum , data_files , include_restart , lazy_load )) {
     ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( data_files , 0 ) , NULL , NULL);
 
     if (file_type == ECL_SUMMARY_FILE)
@@ -220,7 +227,7 @@ static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , con
 }
 
 
-static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
+static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart , bool lazy_load) {
   char * header_file;
   stringlist_type * summary_file_list = stringlist_alloc_new();
 
@@ -228,7 +235,7 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
   ecl_util_alloc_summary_files( ecl_sum->path , ecl_sum->base , ecl_sum->ext , &header_file , summary_file_list );
   if ((header_file != NULL) && (stringlist_get_size( summary_file_list ) > 0)) {
-    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart );
+    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart , lazy_load );
   }
   util_safe_free( header_file );
   stringlist_free( summary_file_list );
@@ -250,7 +257,22 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
 ecl_sum_type * ecl_sum_fread_alloc(const char *header_file , const stringlist_type *data_files , const char * key_join_string) {
   ecl_sum_type * ecl_sum = ecl_sum_alloc__( header_file , key_join_string );
-  ecl_sum_fread( ecl_sum , header_file , data_files , false );
+  ecl_sum_fread( ecl_sum , header_file , data_files , false , false );
+  return ecl_sum;
+}
+
+
+/**
+   As ecl_sum_fread_alloc(), but for unified unformatted summary files
+   the summary vectors are only read from file when they are
+   requested; this is well suited for large cases where only a small
+   subset of the summary vectors are used. See the documentation of
+   lazy loading in ecl_sum_data.c.
+*/
+
+ecl_sum_type * ecl_sum_fread_alloc_lazy(const char *header_file , const stringlist_type *data_files , const char * key_join_string) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc__( header_file , key_join_string );
+  ecl_sum_fread( ecl_sum , header_file , data_files , false , true );
   return ecl_sum;
 }
 
@@ -389,9 +411,9 @@ void ecl_sum_free__(void * __ecl_sum) {
 */
 
 
-ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+static ecl_sum_type * ecl_sum_fread_alloc_case_internal(const char * input_file , const char * key_join_string , bool include_restart , bool lazy_load){
   ecl_sum_type * ecl_sum     = ecl_sum_alloc__(input_file , key_join_string);
-  if (ecl_sum_fread_case( ecl_sum , include_restart))
+  if (ecl_sum_fread_case( ecl_sum , include_restart , lazy_load))
     return ecl_sum;
   else {
     /*
@@ -405,12 +427,28 @@ ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char *
 
 
 
+ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+  return ecl_sum_fread_alloc_case_internal( input_file , key_join_string , include_restart , false );
+}
+
+
 ecl_sum_type * ecl_sum_fread_alloc_case(const char * input_file , const char * key_join_string){
   bool include_restart = true;
   return ecl_sum_fread_alloc_case__( input_file , key_join_string , include_restart );
 }
 
 
+/**
+   Lazy version of ecl_sum_fread_alloc_case(); see the documentation
+   of ecl_sum_fread_alloc_lazy().
+*/
+
+ecl_sum_type * ecl_sum_fread_alloc_case_lazy(const char * input_file , const char * key_join_string){
+  bool include_restart = true;
+  return ecl_sum_fread_alloc_case_internal( input_file , key_join_string , include_restart , true );
+}
+
+
 bool ecl_sum_case_exists( const char * input_file ) {
   char * smspec_file = NULL;
   stringlist_type * data_files = stringlist_alloc_new();
@@ -668,6 +706,11 @@ void ecl_sum_fwrite_interp_csv_line(const ecl_sum_type * ecl_sum, time_t sim_tim
 }
 
 
+void ecl_sum_init_interp_matrix( const ecl_sum_type * ecl_sum , const time_t_vector_type * sim_times , const ecl_sum_vector_type * keylist , double missing_value , double * values) {
+  ecl_sum_data_init_interp_matrix( ecl_sum->data , sim_times , keylist , missing_value , values );
+}
+
+
 
 double ecl_sum_get_general_var_from_sim_time( const ecl_sum_type * ecl_sum , time_t sim_time , const char * var) {
   const smspec_node_type * node = ecl_sum_get_general_var_node( ecl_sum , var );
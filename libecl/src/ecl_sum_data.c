@@ -24,6 +24,16 @@
 #include <ert/util/int_vector.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/time_interval.h>
+#include <ert/util/ert_api_config.h>
+
+#ifdef ERT_HAVE_THREAD_POOL
+#include <pthread.h>
+#endif
+
+#ifdef ERT_HAVE_PREAD
+#include <unistd.h>
+#include <fcntl.h>
+#endif
 
 #include <ert/ecl/ecl_util.h>
 #include <ert/ecl/ecl_smspec.h>
@@ -32,6 +42,8 @@
 #include <ert/ecl/smspec_node.h>
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_file_kw.h>
+#include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_kw_magic.h>
 #include <ert/ecl/ecl_sum_vector.h>
@@ -225,15 +237,219 @@ struct ecl_sum_data_struct {
   time_interval_type     * sim_time;               /* The time interval sim_time goes from the first time value where we have
                                                       data to the end of the simulation. In the case of restarts the start
                                                       value might disagree with the simulation start reported by the smspec file. */
+  bool                     column_store;           /* Should the column store below be used? */
+  int                      num_columns;
+  float                 ** columns;                /* Lazily built column copies of the data; see ecl_sum_data_get_column(). */
+#ifdef ERT_HAVE_THREAD_POOL
+  pthread_mutex_t          column_lock;
+#endif
+  char                   * lazy_file;              /* Unified summary file holding the PARAMS data of lazy tsteps; NULL if not lazy. */
+  int                      lazy_fd;
 };
 
 
 
 
 
+/*****************************************************************/
+/*
+  Lazy loading
+  ------------
+
+  When the data is loaded with ecl_sum_data_fread_lazy() the PARAMS
+  vectors of a unified unformatted summary file are not read at load
+  time; only the MINISTEP numbers and the time information are read,
+  and the tsteps record the offset of their PARAMS keyword in the
+  file. The values are then read on demand with one pread() per
+  ministep when a column is built, i.e. the memory consumption scales
+  with the number of keys actually used and not the total number of
+  keys in the case.
+
+  Operations which need complete tsteps, i.e. writing, scaling and
+  shifting, will first load all the PARAMS data with
+  ecl_sum_data_load_lazy().
+*/
+
+
+static bool ecl_sum_data_open_lazy( ecl_sum_data_type * data , const char * filename ) {
+#ifdef ERT_HAVE_PREAD
+  bool fmt_file;
+  if (data->lazy_file != NULL)
+    return false;
+
+  ecl_util_get_file_type( filename , &fmt_file , NULL );
+  if (fmt_file)
+    return false;
+
+  data->lazy_fd = open( filename , O_RDONLY );
+  if (data->lazy_fd == -1)
+    return false;
+
+  data->lazy_file = util_alloc_string_copy( filename );
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+static void ecl_sum_data_close_lazy( ecl_sum_data_type * data ) {
+#ifdef ERT_HAVE_PREAD
+  if (data->lazy_fd != -1)
+    close( data->lazy_fd );
+#endif
+  data->lazy_fd = -1;
+  util_safe_free( data->lazy_file );
+  data->lazy_file = NULL;
+}
+
+
+static bool ecl_sum_data_pread_param( const ecl_sum_data_type * data , offset_type kw_offset , int params_index , float * value) {
+#ifdef ERT_HAVE_PREAD
+  offset_type pos = ecl_kw_unformatted_element_offset( kw_offset , ECL_FLOAT , params_index );
+  if (pread( data->lazy_fd , value , sizeof * value , pos ) == sizeof * value) {
+    if (ECL_ENDIAN_FLIP)
+      util_endian_flip_vector( value , sizeof * value , 1 );
+    return true;
+  }
+#endif
+  return false;
+}
+
+
+static void ecl_sum_data_load_lazy( const ecl_sum_data_type * const_data ) {
+  ecl_sum_data_type * data = (ecl_sum_data_type *) const_data;
+  if (data->lazy_file == NULL)
+    return;
+  {
+    fortio_type * fortio = fortio_open_reader( data->lazy_file , false , ECL_ENDIAN_FLIP );
+    int i;
+
+    if (fortio == NULL)
+      util_abort("%s: failed to open:%s \n",__func__ , data->lazy_file);
+
+    for (i = 0; i < vector_get_size( data->data ); i++) {
+      ecl_sum_tstep_type * tstep = vector_iget( data->data , i );
+      if (!ecl_sum_tstep_is_loaded( tstep )) {
+        ecl_kw_type * params_kw;
+
+        fortio_fseek( fortio , ecl_sum_tstep_get_file_offset( tstep ) , SEEK_SET );
+        params_kw = ecl_kw_fread_alloc( fortio );
+        if (params_kw == NULL)
+          util_abort("%s: failed to load PARAMS from:%s \n",__func__ , data->lazy_file);
+
+        ecl_sum_tstep_load_data( tstep , params_kw );
+        ecl_kw_free( params_kw );
+      }
+    }
+    fortio_fclose( fortio );
+  }
+  ecl_sum_data_close_lazy( data );
+}
+
+
+/*****************************************************************/
+/*
+  Column store
+  ------------
+
+  The data is stored by time, with one ecl_sum_tstep instance per
+  ministep, i.e. extracting the full time series of one variable means
+  picking one float from each of thousands of separately allocated
+  tstep instances. To speed up the vector oriented access the data is
+  also stored column wise, with one contiguous float array for each
+  params_index. The columns are built lazily on first access, and
+  discarded when tsteps are added to the ecl_sum_data instance.
+
+  For instances created with ecl_sum_data_alloc_writer() the column
+  store is not used, because the tstep instances returned from
+  ecl_sum_data_add_new_tstep() are updated by the calling scope.
+*/
+
+
+static void ecl_sum_data_clear_columns( ecl_sum_data_type * data ) {
+  if (data->columns) {
+    int i;
+    for (i = 0; i < data->num_columns; i++)
+      util_safe_free( data->columns[i] );
+
+    free( data->columns );
+    data->columns = NULL;
+    data->num_columns = 0;
+  }
+}
+
+
+static void ecl_sum_data_lock_columns( const ecl_sum_data_type * data ) {
+#ifdef ERT_HAVE_THREAD_POOL
+  pthread_mutex_lock( (pthread_mutex_t *) &data->column_lock );
+#endif
+}
+
+
+static void ecl_sum_data_unlock_columns( const ecl_sum_data_type * data ) {
+#ifdef ERT_HAVE_THREAD_POOL
+  pthread_mutex_unlock( (pthread_mutex_t *) &data->column_lock );
+#endif
+}
+
+
+/*
+  Will return the column for @params_index, building it if
+  necessary; returns NULL if the column store is not in use or the
+  params_index is invalid, the calling scope should then use the
+  tstep instances directly.
+*/
+
+static const float * ecl_sum_data_get_column( const ecl_sum_data_type * const_data , int params_index) {
+  ecl_sum_data_type * data = (ecl_sum_data_type *) const_data;
+  const float * column = NULL;
+
+  if (!data->column_store)
+    return NULL;
+
+  ecl_sum_data_lock_columns( data );
+  {
+    if (data->columns == NULL) {
+      data->num_columns = ecl_smspec_get_params_size( data->smspec );
+      data->columns = util_calloc( data->num_columns , sizeof * data->columns );
+      for (int i = 0; i < data->num_columns; i++)
+        data->columns[i] = NULL;
+    }
+
+    if ((params_index >= 0) && (params_index < data->num_columns)) {
+      if (data->columns[params_index] == NULL) {
+        int length = vector_get_size( data->data );
+        float * new_column = util_calloc( length , sizeof * new_column );
+        int i;
+
+        for (i = 0; i < length; i++) {
+          const ecl_sum_tstep_type * tstep = vector_iget_const( data->data , i );
+          if (ecl_sum_tstep_is_loaded( tstep ))
+            new_column[i] = ecl_sum_tstep_iget( tstep , params_index );
+          else if (!ecl_sum_data_pread_param( data , ecl_sum_tstep_get_file_offset( tstep ) , params_index , &new_column[i] ))
+            util_abort("%s: failed to read element %d of PARAMS from:%s \n",__func__ , params_index , data->lazy_file);
+        }
+
+        data->columns[params_index] = new_column;
+      }
+      column = data->columns[params_index];
+    }
+  }
+  ecl_sum_data_unlock_columns( data );
+
+  return column;
+}
+
+
 /*****************************************************************/
 
  void ecl_sum_data_free( ecl_sum_data_type * data ) {
+  ecl_sum_data_clear_columns( data );
+  ecl_sum_data_close_lazy( data );
+#ifdef ERT_HAVE_THREAD_POOL
+  pthread_mutex_destroy( &data->column_lock );
+#endif
   vector_free( data->data );
   int_vector_free( data->report_first_index );
   int_vector_free( data->report_last_index  );
@@ -273,6 +489,15 @@ ecl_sum_data_type * ecl_sum_data_alloc(ecl_smspec_type * smspec) {
   data->report_last_index     = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
   data->sim_time              = time_interval_alloc_open();
 
+  data->column_store          = true;
+  data->num_columns           = 0;
+  data->columns               = NULL;
+  data->lazy_file             = NULL;
+  data->lazy_fd               = -1;
+#ifdef ERT_HAVE_THREAD_POOL
+  pthread_mutex_init( &data->column_lock , NULL );
+#endif
+
   ecl_sum_data_clear_index( data );
   return data;
 }
@@ -318,6 +543,7 @@ void ecl_sum_data_report2internal_range(const ecl_sum_data_type * data , int rep
 
 ecl_sum_data_type * ecl_sum_data_alloc_writer( ecl_smspec_type * smspec ) {
   ecl_sum_data_type * data = ecl_sum_data_alloc( smspec );
+  data->column_store = false;
   return data;
 }
 
@@ -421,6 +647,7 @@ static void ecl_sum_data_fwrite_multiple( const ecl_sum_data_type * data , const
 
 
 void ecl_sum_data_fwrite_step( const ecl_sum_data_type * data , const char * ecl_case , bool fmt_case , bool unified, int report_step) {
+  ecl_sum_data_load_lazy( data );
   if (unified)
     ecl_sum_data_fwrite_unified_step( data , ecl_case , fmt_case , report_step);
   else
@@ -429,6 +656,7 @@ void ecl_sum_data_fwrite_step( const ecl_sum_data_type * data , const char * ecl
 
 
 void ecl_sum_data_fwrite( const ecl_sum_data_type * data , const char * ecl_case , bool fmt_case , bool unified) {
+  ecl_sum_data_load_lazy( data );
   if (unified)
     ecl_sum_data_fwrite_unified( data , ecl_case , fmt_case );
   else
@@ -671,7 +899,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
     int index = 0;
     const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , index );
     const ecl_sum_tstep_type * prev_ministep;
-    double value = ecl_sum_tstep_iget( ministep , param_index );
+    double value = ecl_sum_data_iget( data , index , param_index );
     double prev_value;
 
     while (true) {
@@ -683,7 +911,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
       prev_value = value;
 
       ministep = ecl_sum_data_iget_ministep( data , index );
-      value = ecl_sum_tstep_iget( ministep , param_index );
+      value = ecl_sum_data_iget( data , index , param_index );
 
       if ((value == cmp_value) ||
           (((value - cmp_value) * (cmp_value - prev_value)) > 0)) {
@@ -749,6 +977,7 @@ static void ecl_sum_data_append_tstep__( ecl_sum_data_type * data , ecl_sum_tste
   }
 
   vector_append_owned_ref( data->data , tstep , ecl_sum_tstep_free__);
+  ecl_sum_data_clear_columns( data );
   data->index_valid = false;
 }
 
@@ -785,6 +1014,7 @@ static void ecl_sum_data_build_index( ecl_sum_data_type * sum_data ) {
     Sort the internal storage vector after sim_time.
   */
   vector_sort( sum_data->data , cmp_ministep );
+  ecl_sum_data_clear_columns( sum_data );
 
 
   /* Identify various global first and last values.  */
@@ -950,6 +1180,58 @@ static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
 }
 
 
+/*
+  Lazy version of ecl_sum_data_add_ecl_file(); the PARAMS keywords
+  are not loaded, only the time information is read from the file
+  with ecl_sum_data_pread_param(). The @params argument is a work
+  buffer with (at least) params_size elements.
+*/
+
+static void ecl_sum_data_add_ecl_file_lazy(ecl_sum_data_type * data ,
+                                           time_t load_end ,
+                                           int   report_step ,
+                                           const ecl_file_view_type * summary_view,
+                                           float * params) {
+
+  const ecl_smspec_type * smspec = data->smspec;
+  int params_size = ecl_smspec_get_params_size( smspec );
+  int time_index[4] = { ecl_smspec_get_time_index( smspec ),
+                        ecl_smspec_get_date_day_index( smspec ),
+                        ecl_smspec_get_date_month_index( smspec ),
+                        ecl_smspec_get_date_year_index( smspec ) };
+  int num_ministep  = ecl_file_view_get_num_named_kw( summary_view , PARAMS_KW);
+  int ikw;
+
+  for (ikw = 0; ikw < num_ministep; ikw++) {
+    ecl_kw_type * ministep_kw = ecl_file_view_iget_named_kw( summary_view , MINISTEP_KW , ikw);
+    ecl_file_kw_type * params_file_kw = ecl_file_view_iget_named_file_kw( summary_view , PARAMS_KW , ikw);
+    offset_type kw_offset = ecl_file_kw_get_offset( params_file_kw );
+    bool read_ok = true;
+    int i;
+
+    if (ecl_file_kw_get_size( params_file_kw ) != params_size) {
+      fprintf(stderr , "** Warning size mismatch between timestep loaded from:%s and header:%s - timestep discarded.\n" , data->lazy_file , ecl_smspec_get_header_file( smspec ));
+      continue;
+    }
+
+    for (i = 0; i < 4; i++) {
+      if (time_index[i] >= 0)
+        read_ok = read_ok && ecl_sum_data_pread_param( data , kw_offset , time_index[i] , &params[ time_index[i] ]);
+    }
+
+    if (read_ok) {
+      int ministep_nr = ecl_kw_iget_int( ministep_kw , 0 );
+      ecl_sum_tstep_type * tstep = ecl_sum_tstep_alloc_lazy( report_step , ministep_nr , params , kw_offset , smspec );
+
+      if (load_end == 0 || (ecl_sum_tstep_get_sim_time( tstep ) < load_end))
+        ecl_sum_data_append_tstep__( data , tstep );
+      else
+        ecl_sum_tstep_free( tstep );
+    }
+  }
+}
+
+
 void ecl_sum_data_add_case(ecl_sum_data_type * self, const ecl_sum_data_type * other) {
   int * param_mapping = NULL;
   bool  header_equal = ecl_smspec_equal( self->smspec , other->smspec);
@@ -958,6 +1240,8 @@ void ecl_sum_data_add_case(ecl_sum_data_type * self, const ecl_sum_data_type * o
   if (!header_equal)
     param_mapping = ecl_smspec_alloc_mapping( self->smspec , other->smspec );
 
+  ecl_sum_data_load_lazy( other );
+
 
   for (int tstep_nr = 0; tstep_nr < ecl_sum_data_get_length( other ); tstep_nr++) {
     ecl_sum_tstep_type * other_tstep = ecl_sum_data_iget_ministep( other , tstep_nr );
@@ -1004,7 +1288,7 @@ static bool ecl_sum_data_check_file( ecl_file_type * ecl_file ) {
   call to ecl_sum_data_build_index().
 */
 
-static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist) {
+static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist , bool lazy_load) {
   if (stringlist_get_size( filelist ) == 0)
     return false;
 
@@ -1037,6 +1321,11 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
         ecl_file_type * ecl_file = ecl_file_open( stringlist_iget(filelist ,0 ) , 0);
         if (ecl_file && ecl_sum_data_check_file( ecl_file )) {
           int report_step = 1;   /* <- ECLIPSE numbering - starting at 1. */
+          float * params = NULL;
+
+          if (lazy_load && ecl_sum_data_open_lazy( data , stringlist_iget( filelist , 0 )))
+            params = util_calloc( ecl_smspec_get_params_size( data->smspec ) , sizeof * params );
+
           while (true) {
             /*
               Observe that there is a number discrepancy between ECLIPSE
@@ -1047,10 +1336,14 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
             */
             ecl_file_view_type * summary_view = ecl_file_get_summary_view(ecl_file , report_step - 1 );
             if (summary_view) {
-              ecl_sum_data_add_ecl_file( data , load_end , report_step , summary_view , data->smspec);
+              if (params)
+                ecl_sum_data_add_ecl_file_lazy( data , load_end , report_step , summary_view , params );
+              else
+                ecl_sum_data_add_ecl_file( data , load_end , report_step , summary_view , data->smspec);
               report_step++;
             } else break;
           }
+          util_safe_free( params );
           ecl_file_close( ecl_file );
         }
       } else
@@ -1067,7 +1360,19 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
 }
 
 bool ecl_sum_data_fread( ecl_sum_data_type * data , const stringlist_type * filelist) {
-  return ecl_sum_data_fread__( data , 0 , filelist );
+  return ecl_sum_data_fread__( data , 0 , filelist , false );
+}
+
+
+/*
+  As ecl_sum_data_fread(), but if the data is in a unified and
+  unformatted file the PARAMS vectors are loaded on demand; see the
+  documentation of lazy loading above. For other file types this is
+  equivalent to ecl_sum_data_fread().
+*/
+
+bool ecl_sum_data_fread_lazy( ecl_sum_data_type * data , const stringlist_type * filelist) {
+  return ecl_sum_data_fread__( data , 0 , filelist , true );
 }
 
 
@@ -1080,7 +1385,7 @@ static time_t ecl_sum_data_get_load_end( const ecl_sum_data_type * data ) {
 
 void ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_type * filelist) {
   time_t load_end = ecl_sum_data_get_load_end( data );
-  ecl_sum_data_fread__( data , load_end , filelist );
+  ecl_sum_data_fread__( data , load_end , filelist , false );
 }
 
 
@@ -1097,7 +1402,7 @@ void ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_typ
 
 ecl_sum_data_type * ecl_sum_data_fread_alloc( ecl_smspec_type * smspec , const stringlist_type * filelist , bool include_restart) {
   ecl_sum_data_type * data = ecl_sum_data_alloc( smspec );
-  ecl_sum_data_fread__( data , 0 , filelist );
+  ecl_sum_data_fread__( data , 0 , filelist , false );
 
   /*****************************************************************/
   /* OK - now we have loaded all the data. Must sort the internal
@@ -1191,8 +1496,13 @@ int ecl_sum_data_iget_mini_step(const ecl_sum_data_type * data , int internal_in
 
 
 double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int params_index ) {
-  const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
-  return ecl_sum_tstep_iget( ministep_data , params_index);
+  const float * column = ecl_sum_data_get_column( data , params_index );
+  if (column && (time_index >= 0) && (time_index < vector_get_size( data->data )))
+    return column[time_index];
+  else {
+    const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
+    return ecl_sum_tstep_iget( ministep_data , params_index);
+  }
 }
 
 
@@ -1209,42 +1519,130 @@ double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int
 */
 
 double ecl_sum_data_interp_get(const ecl_sum_data_type * data , int time_index1 , int time_index2 , double weight1 , double weight2 , int params_index) {
-  const ecl_sum_tstep_type * ministep_data1 = ecl_sum_data_iget_ministep( data , time_index1 );
-  const ecl_sum_tstep_type * ministep_data2 = ecl_sum_data_iget_ministep( data , time_index2 );
-
-  return ecl_sum_tstep_iget( ministep_data1 , params_index ) * weight1 + ecl_sum_tstep_iget( ministep_data2 , params_index ) * weight2;
+  return ecl_sum_data_iget( data , time_index1 , params_index ) * weight1 + ecl_sum_data_iget( data , time_index2 , params_index ) * weight2;
 }
 
 
-void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
-    int num_keywords = ecl_sum_vector_get_size(keylist);
-    double weight1 , weight2;
-    int    time_index1 , time_index2;
-    double value = 0.0;
-    int i;
+/*
+  Will evaluate all the keys in @keylist at all the times in
+  @sim_times and store the result in the dense matrix @values, which
+  is organized with one row for each key:
 
-    ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
-    for(i = 0; i< num_keywords; i++  ){
-        bool is_rate = ecl_sum_vector_iget_is_rate(keylist, i);
-        int params_index = ecl_sum_vector_iget_param_index(keylist , i);
-        if(is_rate){
-            int time_index;
-            if (sim_time == time_interval_get_start( data->sim_time ))
-                time_index = 0;
-            else
-                time_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
+      values[ikey * num_times + itime]
+
+  The sim_times must be sorted in increasing order; the time axis is
+  then swept once to establish the interpolation indices and weights,
+  which are subsequently applied to all the keys. Rates and state
+  variables are treated as in ecl_sum_data_get_from_sim_time(). Times
+  outside the range of the data are assigned @missing_value.
+*/
 
-           value = ecl_sum_data_iget( data , time_index , params_index);
+void ecl_sum_data_init_interp_matrix( const ecl_sum_data_type * data , const time_t_vector_type * sim_times , const ecl_sum_vector_type * keylist , double missing_value , double * values) {
+  const int num_times = time_t_vector_size( sim_times );
+  const int num_keys  = ecl_sum_vector_get_size( keylist );
+  const int size      = vector_get_size( data->data );
+  int    * index1     = util_calloc( num_times , sizeof * index1 );
+  int    * index2     = util_calloc( num_times , sizeof * index2 );
+  double * weight1    = util_calloc( num_times , sizeof * weight1 );
+  double * weight2    = util_calloc( num_times , sizeof * weight2 );
+
+  if ((num_times > 1) && !time_t_vector_is_sorted( sim_times , false ))
+    util_abort("%s: the sim_times vector must be sorted in increasing order \n",__func__);
+
+  /* Sweep the time axis once. */
+  {
+    int index = 0;
+    int itime;
+    for (itime = 0; itime < num_times; itime++) {
+      time_t sim_time = time_t_vector_iget( sim_times , itime );
+
+      if (ecl_sum_data_check_sim_time( data , sim_time )) {
+        /* index: The first ministep ending at or after sim_time. */
+        while ((index < size) && (ecl_sum_data_iget_sim_time( data , index ) < sim_time))
+          index++;
+
+        index2[itime] = index;
+        if (index == 0) {
+          index1[itime]  = 0;
+          weight1[itime] = 1;
+          weight2[itime] = 0;
         } else {
-           value = ecl_sum_data_interp_get( data , time_index1 , time_index2 , weight1 , weight2 , params_index);
+          time_t sim_time2 = ecl_sum_data_iget_sim_time( data , index );
+          int prev_index = index - 1;
+          while ((prev_index > 0) && (ecl_sum_data_iget_sim_time( data , prev_index ) >= sim_time2))
+            prev_index--;
+          {
+            time_t sim_time1 = ecl_sum_data_iget_sim_time( data , prev_index );
+            double w2 =  (sim_time - sim_time1);
+            double w1 = -(sim_time - sim_time2);
+
+            index1[itime]  = prev_index;
+            weight1[itime] = w1 / (w1 + w2);
+            weight2[itime] = w2 / (w1 + w2);
+          }
+        }
+      } else
+        index2[itime] = INVALID_MINISTEP_NR;
+    }
+  }
 
+  /* Apply the indices and weights to each key in turn. */
+  {
+    int ikey;
+    for (ikey = 0; ikey < num_keys; ikey++) {
+      const int params_index = ecl_sum_vector_iget_param_index( keylist , ikey );
+      const bool is_rate     = ecl_sum_vector_iget_is_rate( keylist , ikey );
+      const float * column   = ecl_sum_data_get_column( data , params_index );
+      double * row           = &values[ ikey * num_times ];
+      int itime;
+
+      if (column) {
+        if (is_rate) {
+          for (itime = 0; itime < num_times; itime++)
+            row[itime] = (index2[itime] == INVALID_MINISTEP_NR) ? missing_value : column[ index2[itime] ];
+        } else {
+          for (itime = 0; itime < num_times; itime++)
+            row[itime] = (index2[itime] == INVALID_MINISTEP_NR) ? missing_value : column[ index1[itime] ] * weight1[itime] + column[ index2[itime] ] * weight2[itime];
         }
-        if(i == 0){
-            fprintf(fp , "%f",value);
-        }else{
-            fprintf(fp , ",%f",value);
+      } else {
+        for (itime = 0; itime < num_times; itime++) {
+          if (index2[itime] == INVALID_MINISTEP_NR)
+            row[itime] = missing_value;
+          else if (is_rate)
+            row[itime] = ecl_sum_data_iget( data , index2[itime] , params_index );
+          else
+            row[itime] = ecl_sum_data_interp_get( data , index1[itime] , index2[itime] , weight1[itime] , weight2[itime] , params_index );
         }
+      }
+    }
+  }
+
+  free( index1 );
+  free( index2 );
+  free( weight1 );
+  free( weight2 );
+}
+
+
+void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
+  int num_keywords = ecl_sum_vector_get_size(keylist);
+  time_t_vector_type * sim_times = time_t_vector_alloc( 1 , sim_time );
+  double * values = util_calloc( num_keywords , sizeof * values );
+  int i;
+
+  if (!ecl_sum_data_check_sim_time( data , sim_time ))
+    ecl_sum_data_get_index_from_sim_time( data , sim_time );   /* Will abort with an informative error message. */
+
+  ecl_sum_data_init_interp_matrix( data , sim_times , keylist , 0 , values );
+  for(i = 0; i< num_keywords; i++  ){
+    if(i == 0){
+      fprintf(fp , "%f",values[i]);
+    }else{
+      fprintf(fp , ",%f",values[i]);
     }
+  }
+  free( values );
+  time_t_vector_free( sim_times );
 }
 
 
@@ -1457,20 +1855,28 @@ time_t_vector_type *  ecl_sum_data_alloc_time_vector( const ecl_sum_data_type *
 
 
 void ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vector_type * data_vector , int data_index , bool report_only) {
+  const float * column = ecl_sum_data_get_column( data , data_index );
   double_vector_reset( data_vector );
   double_vector_append( data_vector , ecl_smspec_get_start_time( data->smspec ));
   if (report_only) {
     int report_step;
     for (report_step = data->first_report_step; report_step <= data->last_report_step; report_step++) {
       int last_index = int_vector_iget(data->report_last_index , report_step);
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , last_index );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      double_vector_append( data_vector , ecl_sum_data_iget( data , last_index , data_index ));
     }
   } else {
+    int length = vector_get_size(data->data);
     int i;
-    for (i = 0; i < vector_get_size(data->data); i++) {
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+
+    if (column) {
+      double_vector_iset( data_vector , length , 0 );   /* Make room for all elements in one go. */
+      for (i = 0; i < length; i++)
+        double_vector_iset( data_vector , i + 1 , column[i] );
+    } else {
+      for (i = 0; i < length; i++) {
+        const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
+        double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      }
     }
   }
 }
@@ -1494,20 +1900,30 @@ int ecl_sum_data_get_length( const ecl_sum_data_type * data ) {
   return vector_get_size( data->data );
 }
 
+/*
+  The column store is discarded and rebuilt on the next access, so
+  the rounding of the updated values is identical in the tsteps and
+  the columns.
+*/
+
 void ecl_sum_data_scale_vector(ecl_sum_data_type * data, int index, double scalar) {
   int len = vector_get_size(data->data);
+  ecl_sum_data_load_lazy( data );
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_iscale(ministep, index, scalar);
   }
+  ecl_sum_data_clear_columns( data );
 }
 
 void ecl_sum_data_shift_vector(ecl_sum_data_type * data, int index, double addend) {
   int len = vector_get_size(data->data);
+  ecl_sum_data_load_lazy( data );
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_ishift(ministep, index, addend);
   }
+  ecl_sum_data_clear_columns( data );
 }
 
 bool ecl_sum_data_report_step_equal( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2) {
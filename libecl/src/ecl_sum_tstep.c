@@ -67,12 +67,18 @@ struct ecl_sum_tstep_struct {
   int                      data_size;       /* Number of elements in data - only used for checking indices. */
   int                      internal_index;  /* Used for lookups of the next / previous ministep based on an existing ministep. */
   const ecl_smspec_type  * smspec;          /* The smespec header information for this tstep - must be compatible. */
+  offset_type              file_offset;     /* For lazy loaded tsteps: offset of the PARAMS keyword in the source file; -1 otherwise. */
 };
 
 
 ecl_sum_tstep_type * ecl_sum_tstep_alloc_remap_copy( const ecl_sum_tstep_type * src , const ecl_smspec_type * new_smspec, float default_value , const int * params_map) {
   int params_size = ecl_smspec_get_params_size( new_smspec );
-  ecl_sum_tstep_type * target = util_alloc_copy(src , sizeof * src );
+  ecl_sum_tstep_type * target;
+
+  if (src->data == NULL)
+    util_abort("%s: data for ministep:%d has not been loaded \n",__func__ , src->ministep);
+
+  target = util_alloc_copy(src , sizeof * src );
 
   target->smspec = new_smspec;
   target->data = util_malloc( params_size * sizeof * target->data );
@@ -90,7 +96,8 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_remap_copy( const ecl_sum_tstep_type *
 
 ecl_sum_tstep_type * ecl_sum_tstep_alloc_copy( const ecl_sum_tstep_type * src ) {
   ecl_sum_tstep_type * target = util_alloc_copy(src , sizeof * src );
-  target->data = util_alloc_copy( src->data , src->data_size * sizeof * src->data );
+  if (src->data)
+    target->data = util_alloc_copy( src->data , src->data_size * sizeof * src->data );
   return target;
 }
 
@@ -103,6 +110,7 @@ static ecl_sum_tstep_type * ecl_sum_tstep_alloc( int report_step , int ministep_
   tstep->ministep    = ministep_nr;
   tstep->data_size   = ecl_smspec_get_params_size( smspec );
   tstep->data        = util_calloc( tstep->data_size , sizeof * tstep->data );
+  tstep->file_offset = -1;
   return tstep;
 }
 
@@ -160,7 +168,7 @@ static void ecl_sum_tstep_set_time_info_from_date( ecl_sum_tstep_type * tstep ,
 }
 
 
-static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_smspec_type * smspec ) {
+static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_smspec_type * smspec , const float * data) {
   int date_day_index   = ecl_smspec_get_date_day_index( smspec );
   int date_month_index = ecl_smspec_get_date_month_index( smspec );
   int date_year_index  = ecl_smspec_get_date_year_index( smspec );
@@ -168,13 +176,13 @@ static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_
   time_t sim_start     = ecl_smspec_get_start_time( smspec );
 
   if (sim_time_index >= 0) {
-    float sim_time = tstep->data[ sim_time_index ];
+    float sim_time = data[ sim_time_index ];
     double sim_seconds = sim_time * ecl_smspec_get_time_seconds( smspec );
     ecl_sum_tstep_set_time_info_from_seconds( tstep , sim_start , sim_seconds );
   } else if ( date_day_index >= 0) {
-    int day   = util_roundf(tstep->data[date_day_index]);
-    int month = util_roundf(tstep->data[date_month_index]);
-    int year  = util_roundf(tstep->data[date_year_index]);
+    int day   = util_roundf(data[date_day_index]);
+    int month = util_roundf(data[date_month_index]);
+    int year  = util_roundf(data[date_year_index]);
 
     time_t sim_time = ecl_util_make_date(day , month , year);
     ecl_sum_tstep_set_time_info_from_date( tstep , sim_start , sim_time );
@@ -202,7 +210,7 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
   if (data_size == ecl_smspec_get_params_size( smspec )) {
     ecl_sum_tstep_type * ministep = ecl_sum_tstep_alloc( report_step , ministep_nr , smspec);
     ecl_kw_get_memcpy_data( params_kw , ministep->data );
-    ecl_sum_tstep_set_time_info( ministep , smspec );
+    ecl_sum_tstep_set_time_info( ministep , smspec , ministep->data );
     return ministep;
   } else {
     /*
@@ -217,6 +225,51 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
 }
 
 
+/*
+  Will allocate a tstep where the actual PARAMS data has not been
+  loaded, only the location of the PARAMS keyword in the source file
+  is recorded. The @params argument is only used to establish the time
+  information, i.e. only the elements corresponding to the time/date
+  indices in the smspec need to be valid. Value access in a lazy tstep
+  will fail until the data has been loaded with
+  ecl_sum_tstep_load_data(); the lazy loading is managed by the
+  ecl_sum_data layer.
+*/
+
+ecl_sum_tstep_type * ecl_sum_tstep_alloc_lazy( int report_step , int ministep_nr , const float * params , offset_type file_offset , const ecl_smspec_type * smspec) {
+  ecl_sum_tstep_type * ministep = util_malloc( sizeof * ministep );
+  UTIL_TYPE_ID_INIT( ministep , ECL_SUM_TSTEP_ID);
+  ministep->smspec      = smspec;
+  ministep->report_step = report_step;
+  ministep->ministep    = ministep_nr;
+  ministep->data_size   = ecl_smspec_get_params_size( smspec );
+  ministep->data        = NULL;
+  ministep->file_offset = file_offset;
+  ecl_sum_tstep_set_time_info( ministep , smspec , params );
+  return ministep;
+}
+
+
+bool ecl_sum_tstep_is_loaded( const ecl_sum_tstep_type * ministep ) {
+  return (ministep->data != NULL);
+}
+
+
+offset_type ecl_sum_tstep_get_file_offset( const ecl_sum_tstep_type * ministep ) {
+  return ministep->file_offset;
+}
+
+
+void ecl_sum_tstep_load_data( ecl_sum_tstep_type * ministep , const ecl_kw_type * params_kw ) {
+  if (ecl_kw_get_size( params_kw ) != ministep->data_size)
+    util_abort("%s: size mismatch - PARAMS keyword has %d elements, expected %d \n",__func__ , ecl_kw_get_size( params_kw ) , ministep->data_size);
+
+  if (ministep->data == NULL)
+    ministep->data = util_calloc( ministep->data_size , sizeof * ministep->data );
+  ecl_kw_get_memcpy_data( params_kw , ministep->data );
+}
+
+
 /*
   Should be called in write mode.
 */
@@ -235,6 +288,9 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , f
 
 
 double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index) {
+  if (ministep->data == NULL)
+    util_abort("%s: data for ministep:%d has not been loaded \n",__func__ , ministep->ministep);
+
   if ((index >= 0) && (index < ministep->data_size))
     return ministep->data[index];
   else {
@@ -270,6 +326,9 @@ int ecl_sum_tstep_get_ministep(const ecl_sum_tstep_type * ministep) {
 /*****************************************************************/
 
 void ecl_sum_tstep_fwrite( const ecl_sum_tstep_type * ministep , const int_vector_type * index_map , fortio_type * fortio) {
+  if (ministep->data == NULL)
+    util_abort("%s: data for ministep:%d has not been loaded \n",__func__ , ministep->ministep);
+
   {
     ecl_kw_type * ministep_kw = ecl_kw_alloc( MINISTEP_KW , 1 , ECL_INT );
     ecl_kw_iset_int( ministep_kw , 0 , ministep->ministep );
@@ -298,6 +357,9 @@ void ecl_sum_tstep_fwrite( const ecl_sum_tstep_type * ministep , const int_vecto
 /*****************************************************************/
 
 void ecl_sum_tstep_iset( ecl_sum_tstep_type * tstep , int index , float value) {
+  if (tstep->data == NULL)
+    util_abort("%s: data for ministep:%d has not been loaded \n",__func__ , tstep->ministep);
+
   if ((index < tstep->data_size) && (index >= 0))
     tstep->data[index] = value;
   else
@@ -98,6 +98,23 @@ const char * ecl_type_get_name(const ecl_data_type ecl_type) {
   }
 }
 
+/*
+  Will check whether @type_name is one of the recognized type names;
+  can be used to guard ecl_type_create_from_name() which will abort
+  on an invalid name.
+*/
+
+bool ecl_type_is_valid_name( const char * type_name ) {
+  return ((strncmp( type_name , ECL_TYPE_NAME_FLOAT   , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_INT     , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_DOUBLE  , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_CHAR    , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_C010    , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_MESSAGE , ECL_TYPE_LENGTH) == 0) ||
+          (strncmp( type_name , ECL_TYPE_NAME_BOOL    , ECL_TYPE_LENGTH) == 0));
+}
+
+
 ecl_data_type ecl_type_create_from_name( const char * type_name ) {
   if (strncmp( type_name , ECL_TYPE_NAME_FLOAT , ECL_TYPE_LENGTH) == 0)
     return ECL_FLOAT;
@@ -22,6 +22,11 @@
 #include <string.h>
 #include <errno.h>
 
+#include <ert/util/ert_api_config.h>
+#ifdef ERT_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
 #include <ert/ecl/fortio.h>
@@ -90,6 +95,15 @@ struct fortio_struct {
   */
   bool               readable;
   offset_type        read_size;
+
+  /*
+    When the file has been mapped with fortio_mmap() the complete file
+    content is available through the read-only mmap_ptr; the mapping
+    is independent of the FILE * stream and stays valid until
+    fortio_munmap() or fortio_fclose() is called.
+  */
+  char             * mmap_ptr;
+  offset_type        mmap_size;
 };
 
 
@@ -105,6 +119,8 @@ static fortio_type * fortio_alloc__(const char *filename , bool fmt_file , bool
   fortio->stream_owner       = stream_owner;
   fortio->read_size          = 0;
   fortio->readable           = readable;
+  fortio->mmap_ptr           = NULL;
+  fortio->mmap_size          = 0;
   return fortio;
 }
 
@@ -396,6 +412,7 @@ bool fortio_assert_stream_open( fortio_type * fortio ) {
 
 
 static void fortio_free__(fortio_type * fortio) {
+  fortio_munmap( fortio );
   util_safe_free(fortio->filename);
   free(fortio);
 }
@@ -474,18 +491,28 @@ bool fortio_data_fskip(fortio_type* fortio, const int element_size, const int el
 }
 
 
+/*
+  Will return the file offset of element @data_element in a data
+  section starting at @data_offset and written in blocks of
+  @block_size elements, i.e. the data_offset should point to the
+  header of the first block. Observe that this is only meaningful for
+  unformatted files.
+*/
+
+offset_type fortio_data_element_offset(offset_type data_offset, size_t data_element, const int element_size, const int block_size) {
+  int block_index = data_element / block_size;
+  int headers = (block_index + 1) * 4;
+  int trailers = block_index * 4;
+
+  return data_offset + headers + trailers + ((offset_type) data_element * element_size);
+}
+
+
 void fortio_data_fseek(fortio_type* fortio, offset_type data_offset, size_t data_element, const int element_size, const int element_count, const int block_size) {
     if(data_element < 0 || data_element >= element_count) {
         util_abort("%s: Element index is out of range: 0 <= %d < %d \n", __func__, data_element, element_count);
     }
-    {
-      int block_index = data_element / block_size;
-      int headers = (block_index + 1) * 4;
-      int trailers = block_index * 4;
-      offset_type bytes_to_skip = data_offset + headers + trailers + (data_element * element_size);
-
-      fortio_fseek(fortio, bytes_to_skip, SEEK_SET);
-    }
+    fortio_fseek(fortio, fortio_data_element_offset( data_offset , data_element , element_size , block_size ), SEEK_SET);
 }
 
 
@@ -562,6 +589,68 @@ bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size)
 }
 
 
+/**
+   Reads @elements elements of size @element_size which have been
+   written as a sequence of records with @block_elements elements in
+   each record, i.e. the layout used for ECLIPSE keywords. The complete
+   payload, including the record markers, is read with one fread()
+   call, and the data is copied to @buffer - endian flipped if
+   @flip_data is true - in one pass.
+
+   If the records on disk do not have the expected sizes, or the file
+   is too short, the function returns false and the stream is
+   repositioned at the start of the payload; the caller can then fall
+   back to fortio_fread_buffer().
+*/
+
+bool fortio_fread_blocks(fortio_type * fortio , char * buffer , int element_size , int elements , int block_elements , bool flip_data) {
+  const int    num_blocks   = elements / block_elements + (elements % block_elements == 0 ? 0 : 1);
+  const size_t payload_size = (size_t) num_blocks * 2 * sizeof(int) + (size_t) element_size * elements;
+  const offset_type start_pos = fortio_ftell( fortio );
+  char * payload = util_malloc( payload_size );
+  bool read_ok = (fread( payload , 1 , payload_size , fortio->stream ) == payload_size);
+
+  if (read_ok) {
+    const char * record_ptr = payload;
+    int block;
+
+    for (block = 0; block < num_blocks; block++) {
+      const int block_size = (util_int_min( (block + 1) * block_elements , elements ) - block * block_elements) * element_size;
+      int header , trailer;
+
+      memcpy( &header , record_ptr , sizeof header );
+      memcpy( &trailer , &record_ptr[ sizeof header + block_size ] , sizeof trailer );
+      if (fortio->endian_flip_header) {
+        util_endian_flip_vector( &header , sizeof header , 1 );
+        util_endian_flip_vector( &trailer , sizeof trailer , 1 );
+      }
+
+      if ((header != block_size) || (trailer != block_size)) {
+        read_ok = false;
+        break;
+      }
+
+      {
+        char * target = &buffer[ (size_t) block * block_elements * element_size ];
+        if (flip_data)
+          util_endian_flip_copy( target , &record_ptr[ sizeof header ] , element_size , block_size / element_size );
+        else
+          memcpy( target , &record_ptr[ sizeof header ] , block_size );
+      }
+      record_ptr += block_size + 2 * sizeof(int);
+    }
+  }
+
+  if (!read_ok) {
+    clearerr( fortio->stream );
+    fortio_fseek( fortio , start_pos , SEEK_SET );
+  }
+
+  free( payload );
+  return read_ok;
+}
+
+
 int fortio_fskip_record(fortio_type *fortio) {
   int record_size = fortio_init_read(fortio);
   fortio_fseek(fortio , (offset_type) record_size , SEEK_CUR);
@@ -628,6 +717,42 @@ void fortio_complete_write(fortio_type *fortio , int record_size) {
 }
 
 
+/**
+   The mirror image of fortio_fread_blocks(): the records, including
+   the record markers, are assembled in one buffer which is written
+   with one fwrite() call. The data in @buffer is not modified.
+*/
+
+void fortio_fwrite_blocks(fortio_type * fortio , const char * buffer , int element_size , int elements , int block_elements , bool flip_data) {
+  const int    num_blocks   = elements / block_elements + (elements % block_elements == 0 ? 0 : 1);
+  const size_t payload_size = (size_t) num_blocks * 2 * sizeof(int) + (size_t) element_size * elements;
+  char * payload = util_malloc( payload_size );
+  char * record_ptr = payload;
+  int block;
+
+  for (block = 0; block < num_blocks; block++) {
+    const int block_size = (util_int_min( (block + 1) * block_elements , elements ) - block * block_elements) * element_size;
+    const char * src = &buffer[ (size_t) block * block_elements * element_size ];
+    int marker = block_size;
+
+    if (fortio->endian_flip_header)
+      util_endian_flip_vector( &marker , sizeof marker , 1 );
+
+    memcpy( record_ptr , &marker , sizeof marker );
+    if (flip_data)
+      util_endian_flip_copy( &record_ptr[ sizeof marker ] , src , element_size , block_size / element_size );
+    else
+      memcpy( &record_ptr[ sizeof marker ] , src , block_size );
+    memcpy( &record_ptr[ sizeof marker + block_size ] , &marker , sizeof marker );
+
+    record_ptr += block_size + 2 * sizeof(int);
+  }
+
+  util_fwrite( payload , 1 , payload_size , fortio->stream , __func__ );
+  free( payload );
+}
+
+
 void fortio_fwrite_record(fortio_type *fortio, const char *buffer , int record_size) {
   fortio_init_write(fortio , record_size);
   util_fwrite( buffer , 1 , record_size , fortio->stream , __func__);
@@ -820,6 +945,124 @@ bool fortio_read_at_eof( fortio_type * fortio ) {
 }
 
 
+/*****************************************************************/
+/*
+  Memory mapped reading. The fortio_mmap() function will map the
+  complete file read-only into memory, and the records can then be
+  accessed with fortio_mmap_record() without going through the stdio
+  buffers. Only unformatted files can be mapped, and the mapping is
+  only available on platforms with mmap(); on failure the function
+  returns false and the fortio instance is unchanged - i.e. the caller
+  should fall back to the normal stream based functions.
+*/
+
+bool fortio_mmap( fortio_type * fortio ) {
+#ifdef ERT_HAVE_MMAP
+  if (fortio->mmap_ptr)
+    return true;
+
+  if (fortio->fmt_file || !fortio->stream)
+    return false;
+
+  {
+    offset_type file_size = util_fd_size( fortio_fileno( fortio ));
+    if (file_size > 0) {
+      void * ptr = mmap( NULL , file_size , PROT_READ , MAP_SHARED , fortio_fileno( fortio ) , 0 );
+      if (ptr != MAP_FAILED) {
+        fortio->mmap_ptr = ptr;
+        fortio->mmap_size = file_size;
+        return true;
+      }
+    }
+  }
+#endif
+  return false;
+}
+
+
+void fortio_munmap( fortio_type * fortio ) {
+#ifdef ERT_HAVE_MMAP
+  if (fortio->mmap_ptr) {
+    munmap( fortio->mmap_ptr , fortio->mmap_size );
+    fortio->mmap_ptr = NULL;
+    fortio->mmap_size = 0;
+  }
+#endif
+}
+
+
+bool fortio_is_mmapped( const fortio_type * fortio ) {
+  if (fortio->mmap_ptr)
+    return true;
+  else
+    return false;
+}
+
+
+offset_type fortio_mmap_size( const fortio_type * fortio ) {
+  return fortio->mmap_size;
+}
+
+
+/*
+  Will return the record size found in the header marker at @offset
+  in the mapped file, or -1 if @offset is beyond the end of the
+  file. The tail marker is not checked.
+*/
+
+int fortio_mmap_record_size( const fortio_type * fortio , offset_type offset ) {
+  int header;
+
+  if (offset + (offset_type) sizeof header > fortio->mmap_size)
+    return -1;
+
+  memcpy( &header , &fortio->mmap_ptr[offset] , sizeof header );
+  if (fortio->endian_flip_header)
+    util_endian_flip_vector(&header , sizeof header , 1);
+
+  return header;
+}
+
+
+/*
+  Will return a pointer to the payload of the record starting at
+  *offset in the mapped file, and update *offset to point to the
+  start of the next record. The header and tail markers are checked
+  for consistency; if the record is not complete, or the markers
+  do not agree, the function returns NULL and *offset is not
+  updated.
+*/
+
+const char * fortio_mmap_record( const fortio_type * fortio , offset_type * offset , int * record_size) {
+  offset_type pos = *offset;
+  int header , tail;
+
+  if (pos + (offset_type) sizeof header > fortio->mmap_size)
+    return NULL;
+
+  memcpy( &header , &fortio->mmap_ptr[pos] , sizeof header );
+  if (fortio->endian_flip_header)
+    util_endian_flip_vector(&header , sizeof header , 1);
+
+  if (header < 0)
+    return NULL;
+
+  if (pos + (offset_type) (2 * sizeof header) + header > fortio->mmap_size)
+    return NULL;
+
+  memcpy( &tail , &fortio->mmap_ptr[pos + sizeof header + header] , sizeof tail );
+  if (fortio->endian_flip_header)
+    util_endian_flip_vector(&tail , sizeof tail , 1);
+
+  if (tail != header)
+    return NULL;
+
+  *record_size = header;
+  *offset = pos + 2 * sizeof header + header;
+  return &fortio->mmap_ptr[pos + sizeof header];
+}
+
+
 /*****************************************************************/
 void          fortio_fflush(fortio_type * fortio) { fflush( fortio->stream); }
 FILE        * fortio_get_FILE(const fortio_type *fortio)        { return fortio->stream; }
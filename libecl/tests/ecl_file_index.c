@@ -0,0 +1,127 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_index.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_file( const char * filename , int num_kw ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( "INTKW" , 1500 , ECL_INT );
+    ecl_kw_type * char_kw = ecl_kw_alloc( "CHARKW" , 120 , ECL_CHAR );
+    int i;
+
+    for (i=0; i < 1500; i++)
+      ecl_kw_iset_int( int_kw , i , i );
+
+    for (i=0; i < 120; i++)
+      ecl_kw_iset_string8( char_kw , i , "INTKW" );
+
+    for (i=0; i < num_kw; i++) {
+      ecl_kw_iset_int( int_kw , 0 , i );
+      ecl_kw_fwrite( int_kw , fortio );
+      ecl_kw_fwrite( char_kw , fortio );
+    }
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( char_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_equal( const ecl_file_type * file1 , const ecl_file_type * file2) {
+  int i;
+  test_assert_int_equal( ecl_file_get_size( file1 ) , ecl_file_get_size( file2 ));
+  for (i=0; i < ecl_file_get_size( file1 ); i++)
+    test_assert_true( ecl_kw_equal( ecl_file_iget_kw( file1 , i ) , ecl_file_iget_kw( file2 , i )));
+}
+
+
+void test_index( const char * filename ) {
+  ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+
+  test_assert_false( util_file_exists( "TEST.index" ));
+  {
+    ecl_file_type * fast_file = ecl_file_fast_open( filename , "TEST.index" , 0 );
+    test_assert_true( util_file_exists( "TEST.index" ));
+    test_equal( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+  }
+
+  /* Second open will load the index. */
+  {
+    ecl_file_type * fast_file = ecl_file_fast_open( filename , "TEST.index" , ECL_FILE_CLOSE_STREAM );
+    test_equal( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+  }
+
+  {
+    ecl_file_type * index_file = ecl_file_open( filename , ECL_FILE_INDEX + ECL_FILE_MMAP );
+    char * index_filename = util_alloc_sprintf("%s.index" , filename );
+    test_assert_true( util_file_exists( index_filename ));
+    test_equal( ecl_file , index_file );
+    ecl_file_close( index_file );
+    free( index_filename );
+  }
+  ecl_file_close( ecl_file );
+}
+
+
+void test_invalid_index( const char * filename ) {
+  /* The file is rewritten with a different number of keywords; the stale index must be discarded. */
+  write_file( filename , 7 );
+  {
+    ecl_file_type * fast_file = ecl_file_fast_open( filename , "TEST.index" , 0 );
+    test_assert_int_equal( 14 , ecl_file_get_size( fast_file ));
+    ecl_file_close( fast_file );
+  }
+
+  {
+    FILE * stream = util_fopen( "TEST.index" , "w");
+    fprintf(stream , "Garbage");
+    fclose( stream );
+  }
+  {
+    ecl_file_type * fast_file = ecl_file_fast_open( filename , "TEST.index" , 0 );
+    test_assert_int_equal( 14 , ecl_file_get_size( fast_file ));
+    ecl_file_close( fast_file );
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_index");
+  write_file( "TEST.UNRST" , 1000 );
+
+  test_index( "TEST.UNRST" );
+  test_invalid_index( "TEST.UNRST" );
+
+  test_work_area_free( work_area );
+  exit(0);
+}
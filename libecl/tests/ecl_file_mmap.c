@@ -0,0 +1,130 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_mmap.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_file( const char * filename ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( "INTKW" , 2500 , ECL_INT );
+    ecl_kw_type * float_kw = ecl_kw_alloc( "FLOATKW" , 1000 , ECL_FLOAT );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLEKW" , 1001 , ECL_DOUBLE );
+    ecl_kw_type * char_kw = ecl_kw_alloc( "CHARKW" , 250 , ECL_CHAR );
+    ecl_kw_type * empty_kw = ecl_kw_alloc( "EMPTY" , 0 , ECL_INT );
+    int i;
+
+    for (i=0; i < 2500; i++)
+      ecl_kw_iset_int( int_kw , i , i );
+
+    for (i=0; i < 1000; i++)
+      ecl_kw_iset_float( float_kw , i , i * 0.25 );
+
+    for (i=0; i < 1001; i++)
+      ecl_kw_iset_double( double_kw , i , i * 1.0 / 3 );
+
+    for (i=0; i < 250; i++) {
+      char * s = util_alloc_sprintf("S%d" , i);
+      ecl_kw_iset_string8( char_kw , i , s );
+      free( s );
+    }
+
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( empty_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( float_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( char_kw );
+    ecl_kw_free( empty_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_equal( const char * filename ) {
+  ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+  ecl_file_type * mmap_file = ecl_file_open( filename , ECL_FILE_MMAP );
+
+  test_assert_true( ecl_file_is_instance( mmap_file ));
+  test_assert_int_equal( ecl_file_get_size( ecl_file ) , ecl_file_get_size( mmap_file ));
+  test_assert_int_equal( 6 , ecl_file_get_size( mmap_file ));
+  test_assert_int_equal( 2 , ecl_file_get_num_named_kw( mmap_file , "INTKW" ));
+  {
+    int i;
+    for (i=0; i < ecl_file_get_size( ecl_file ); i++)
+      test_assert_true( ecl_kw_equal( ecl_file_iget_kw( ecl_file , i ) , ecl_file_iget_kw( mmap_file , i )));
+  }
+  test_assert_string_equal( "S17     " , ecl_kw_iget_char_ptr( ecl_file_iget_named_kw( mmap_file , "CHARKW" , 0 ) , 17 ));
+
+  ecl_file_close( ecl_file );
+  ecl_file_close( mmap_file );
+}
+
+
+void test_close_stream( const char * filename ) {
+  util_copy_file( filename , "COPY.UNRST" );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "COPY.UNRST" , ECL_FILE_MMAP + ECL_FILE_CLOSE_STREAM );
+    unlink( "COPY.UNRST" );
+
+    /* The mapping keeps the content available after the file has been removed. */
+    test_assert_true( ecl_file_load_all( ecl_file ));
+    test_assert_int_equal( 2499 , ecl_kw_iget_int( ecl_file_iget_named_kw( ecl_file , "INTKW" , 1 ) , 2499 ));
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+void test_truncated( const char * filename ) {
+  util_copy_file( filename , "TRUNCATED.UNRST" );
+  {
+    offset_type file_size = util_file_size( "TRUNCATED.UNRST" );
+    FILE * stream = util_fopen( "TRUNCATED.UNRST" , "r+");
+    util_ftruncate( stream , file_size - 100 );
+    fclose( stream );
+  }
+  test_assert_NULL( ecl_file_open( "TRUNCATED.UNRST" , ECL_FILE_MMAP ));
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_mmap");
+  write_file( "TEST.UNRST" );
+
+  test_equal( "TEST.UNRST" );
+  test_close_stream( "TEST.UNRST" );
+  test_truncated( "TEST.UNRST" );
+
+  test_work_area_free( work_area );
+  exit(0);
+}
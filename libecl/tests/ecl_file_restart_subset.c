@@ -0,0 +1,119 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_restart_subset.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/int_vector.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_kw_magic.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_kw( fortio_type * fortio , const char * kw , int size , float value) {
+  ecl_kw_type * ecl_kw = ecl_kw_alloc( kw , size , ECL_FLOAT );
+  ecl_kw_scalar_set_float( ecl_kw , value );
+  ecl_kw_fwrite( ecl_kw , fortio );
+  ecl_kw_free( ecl_kw );
+}
+
+
+void write_file( const char * filename ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  int report_step;
+
+  for (report_step = 0; report_step < 5; report_step++) {
+    ecl_kw_type * seqnum_kw = ecl_kw_alloc( SEQNUM_KW , 1 , ECL_INT );
+    ecl_kw_type * intehead_kw = ecl_kw_alloc( INTEHEAD_KW , 100 , ECL_INT );
+
+    ecl_kw_iset_int( seqnum_kw , 0 , report_step );
+    ecl_kw_scalar_set_int( intehead_kw , 0 );
+    ecl_kw_fwrite( seqnum_kw , fortio );
+    ecl_kw_fwrite( intehead_kw , fortio );
+
+    write_kw( fortio , "PRESSURE" , 1000 , 100 + report_step );
+    write_kw( fortio , "SWAT" , 1000 , 0.1 * report_step );
+    write_kw( fortio , "SGAS" , 1000 , 0.2 * report_step );
+
+    ecl_kw_free( seqnum_kw );
+    ecl_kw_free( intehead_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_all( const char * filename ) {
+  ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+  ecl_file_type * subset_file = ecl_file_open_restart_subset( filename , NULL , NULL , 0 );
+
+  test_assert_int_equal( ecl_file_get_size( ecl_file ) , ecl_file_get_size( subset_file ));
+  ecl_file_close( ecl_file );
+  ecl_file_close( subset_file );
+}
+
+
+void test_subset( const char * filename ) {
+  stringlist_type * kw_list = stringlist_alloc_new();
+  int_vector_type * report_steps = int_vector_alloc(0,0);
+
+  stringlist_append_ref( kw_list , "PRESSURE" );
+  int_vector_append( report_steps , 3 );
+  int_vector_append( report_steps , 1 );
+  {
+    ecl_file_type * ecl_file = ecl_file_open_restart_subset( filename , kw_list , report_steps , 0 );
+
+    test_assert_int_equal( 6 , ecl_file_get_size( ecl_file ));
+    test_assert_int_equal( 2 , ecl_file_get_num_named_kw( ecl_file , SEQNUM_KW ));
+    test_assert_int_equal( 2 , ecl_file_get_num_named_kw( ecl_file , INTEHEAD_KW ));
+    test_assert_false( ecl_file_has_kw( ecl_file , "SWAT" ));
+    {
+      ecl_file_view_type * view = ecl_file_get_restart_view( ecl_file , -1 , 3 , -1 , -1 );
+      ecl_kw_type * pressure = ecl_file_view_iget_named_kw( view , "PRESSURE" , 0 );
+      test_assert_float_equal( 103 , ecl_kw_iget_float( pressure , 0 ));
+      test_assert_NULL( ecl_file_get_restart_view( ecl_file , -1 , 2 , -1 , -1 ));
+    }
+    ecl_file_close( ecl_file );
+  }
+
+  /* Keyword whitelist only - all report steps. */
+  {
+    ecl_file_type * ecl_file = ecl_file_open_restart_subset( filename , kw_list , NULL , 0 );
+    test_assert_int_equal( 15 , ecl_file_get_size( ecl_file ));
+    ecl_file_close( ecl_file );
+  }
+  stringlist_free( kw_list );
+  int_vector_free( report_steps );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_restart_subset");
+  write_file( "TEST.UNRST" );
+
+  test_all( "TEST.UNRST" );
+  test_subset( "TEST.UNRST" );
+
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,174 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_fscanf.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_fscanf.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void test_parse_double( const char * s , double expected , int length) {
+  double value;
+  const char * end_ptr = ecl_fscanf_parse_double( s , &value );
+  test_assert_not_NULL( end_ptr );
+  test_assert_int_equal( length , end_ptr - s );
+  test_assert_double_equal( expected , value );
+}
+
+
+void test_parse() {
+  int int_value , multiplier;
+
+  test_parse_double( "0.12345678E+03" , 123.45678 , 14 );
+  test_parse_double( "-0.12345678901234D-02" , -0.0012345678901234 , 21 );
+  test_parse_double( "1e5" , 1e5 , 3 );
+  test_parse_double( ".5" , 0.5 , 2 );
+  test_parse_double( "7." , 7 , 2 );
+  test_parse_double( "0.2/" , 0.2 , 3 );
+  test_parse_double( "1.5E" , 1.5 , 3 );
+  test_parse_double( "0.1234567890123456789012E+300" , 0.1234567890123456789012E+300 , 29 );
+  test_assert_NULL( ecl_fscanf_parse_double( "F" , NULL ));
+  test_assert_NULL( ecl_fscanf_parse_double( "-." , NULL ));
+
+  test_assert_not_NULL( ecl_fscanf_parse_int( "-17" , &int_value ));
+  test_assert_int_equal( -17 , int_value );
+  test_assert_NULL( ecl_fscanf_parse_int( "X" , &int_value ));
+
+  test_assert_string_equal( "0.15" , ecl_fscanf_parse_repeat( "10000*0.15" , &multiplier ));
+  test_assert_int_equal( 10000 , multiplier );
+  test_assert_NULL( ecl_fscanf_parse_repeat( "0.15" , &multiplier ));
+}
+
+
+/* The old implementation of the formatted writer. */
+static void sprintf_scientific_old(char * buffer, const char * fmt , double x) {
+  double pow_x = ceil(log10(fabs(x)));
+  double arg_x   = x / pow(10.0 , pow_x);
+  if (x != 0.0) {
+    if (fabs(arg_x) == 1.0) {
+      arg_x *= 0.10;
+      pow_x += 1;
+    }
+  } else {
+    arg_x = 0.0;
+    pow_x = 0.0;
+  }
+  sprintf(buffer , fmt , arg_x , (int) pow_x);
+}
+
+
+void test_sprintf() {
+  const double values[] = {0 , 1 , -1 , 0.5 , 123.45678 , -0.00012345678 , 1e10 , 99.5 , 0.1 , 1e-200 , 123456789.0};
+  int i;
+  for (i = 0; i < sizeof values / sizeof values[0]; i++) {
+    char buffer1[64];
+    char buffer2[64];
+
+    sprintf_scientific_old( buffer1 , "%11.8fE%+03d" , (float) values[i] );
+    ecl_fscanf_sprintf_scientific( buffer2 , 8 , 'E' , (float) values[i] );
+    test_assert_string_equal( buffer1 , buffer2 );
+
+    sprintf_scientific_old( buffer1 , "%17.14fD%+03d" , values[i] );
+    ecl_fscanf_sprintf_scientific( buffer2 , 14 , 'D' , values[i] );
+    test_assert_string_equal( buffer1 , buffer2 );
+  }
+}
+
+
+void test_formatted_roundtrip() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_fscanf");
+  ecl_kw_type * float_kw = ecl_kw_alloc( "FLOAT" , 2500 , ECL_FLOAT );
+  ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 2500 , ECL_DOUBLE );
+  ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , 2500 , ECL_INT );
+  int i;
+
+  for (i = 0; i < 2500; i++) {
+    ecl_kw_iset_float( float_kw , i , (i - 1000) * 0.125 );
+    ecl_kw_iset_double( double_kw , i , i / 3.0 );
+    ecl_kw_iset_int( int_kw , i , i - 1000 );
+  }
+
+  {
+    fortio_type * fortio = fortio_open_writer( "TEST.FUNRST" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+    fortio_fclose( fortio );
+  }
+
+  {
+    fortio_type * fortio = fortio_open_reader( "TEST.FUNRST" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_type * float_kw2 = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * double_kw2 = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * int_kw2 = ecl_kw_fread_alloc( fortio );
+
+    test_assert_true( ecl_kw_equal( float_kw , float_kw2 ));
+    test_assert_true( ecl_kw_equal( int_kw , int_kw2 ));
+    test_assert_true( ecl_kw_numeric_equal( double_kw , double_kw2 , 1e-10 , 1e-13 ));
+
+    ecl_kw_free( float_kw2 );
+    ecl_kw_free( double_kw2 );
+    ecl_kw_free( int_kw2 );
+    fortio_fclose( fortio );
+  }
+
+  ecl_kw_free( float_kw );
+  ecl_kw_free( double_kw );
+  ecl_kw_free( int_kw );
+  test_work_area_free( work_area );
+}
+
+
+void test_grdecl_repeat() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_fscanf_grdecl");
+  {
+    FILE * stream = util_fopen( "PORO.grdecl" , "w");
+    fprintf(stream , "PORO\n-- A comment 3*0.5\n 3*0.25 0.5 2*1.0D-01\n0.75 /\n");
+    fclose( stream );
+  }
+  {
+    FILE * stream = util_fopen( "PORO.grdecl" , "r");
+    ecl_kw_type * poro = ecl_kw_fscanf_alloc_grdecl_dynamic( stream , "PORO" , ECL_FLOAT );
+
+    test_assert_int_equal( 7 , ecl_kw_get_size( poro ));
+    test_assert_float_equal( 0.25 , ecl_kw_iget_float( poro , 2 ));
+    test_assert_float_equal( 0.50 , ecl_kw_iget_float( poro , 3 ));
+    test_assert_float_equal( 0.10 , ecl_kw_iget_float( poro , 5 ));
+    test_assert_float_equal( 0.75 , ecl_kw_iget_float( poro , 6 ));
+
+    ecl_kw_free( poro );
+    fclose( stream );
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main(int argc , char ** argv) {
+  test_parse();
+  test_sprintf();
+  test_formatted_roundtrip();
+  test_grdecl_repeat();
+  exit(0);
+}
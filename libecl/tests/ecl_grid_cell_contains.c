@@ -22,6 +22,7 @@
 #include <math.h>
 
 #include <ert/util/test_util.h>
+#include <ert/util/util.h>
 #include <ert/ecl/ecl_grid.h>
 
 
@@ -244,6 +245,48 @@ void test_corners() {
 
 
 
+/*
+  The bucket index must give exactly the same answer as a linear scan
+  over all the cells; we test cell centers, cell corners and points
+  outside the grid.
+*/
+
+static int linear_find( const ecl_grid_type * grid , double x , double y , double z) {
+  for (int global_index = 0; global_index < ecl_grid_get_global_size( grid ); global_index++)
+    if (ecl_grid_cell_contains_xyz1( grid , global_index , x , y , z))
+      return global_index;
+  return -1;
+}
+
+
+void test_locate( ecl_grid_type * grid ) {
+  int global_size = ecl_grid_get_global_size( grid );
+  int step = util_int_max( 1 , global_size / 100 );
+
+  ecl_grid_init_xyz_index( grid );
+  test_assert_true( ecl_grid_has_xyz_index( grid ));
+
+  for (int global_index = 0; global_index < global_size; global_index += step) {
+    double x,y,z;
+
+    ecl_grid_get_xyz1( grid , global_index , &x , &y , &z );
+    test_assert_int_equal( linear_find( grid , x , y , z ) , ecl_grid_locate_xyz( grid , x , y , z ));
+
+    for (int corner = 0; corner < 8; corner++) {
+      ecl_grid_get_cell_corner_xyz1( grid , global_index , corner , &x , &y , &z );
+      test_assert_int_equal( linear_find( grid , x , y , z ) , ecl_grid_locate_xyz( grid , x , y , z ));
+    }
+  }
+
+  {
+    double x,y,z;
+    ecl_grid_get_cell_corner_xyz1( grid , 0 , 0 , &x , &y , &z );
+    test_assert_int_equal( -1 , ecl_grid_locate_xyz( grid , x - 1e6 , y , z ));
+    test_assert_int_equal( -1 , ecl_grid_locate_xyz( grid , x , y , z + 1e6 ));
+  }
+}
+
+
 int main(int argc , char ** argv) {
   ecl_grid_type * grid;
 
@@ -259,6 +302,7 @@ int main(int argc , char ** argv) {
 
 
   test_find(grid);
+  test_locate(grid);
   test_corners();
   ecl_grid_free( grid );
   exit(0);
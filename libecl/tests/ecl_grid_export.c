@@ -153,6 +153,51 @@ void export_mapaxes( const ecl_grid_type * grid , ecl_file_type * ecl_file ) {
 
 
 
+void export_cell_data( const ecl_grid_type * grid ) {
+  int active_size = ecl_grid_get_active_size( grid );
+  int * global_index = util_malloc( active_size * sizeof * global_index );
+  int * i = util_malloc( active_size * sizeof * i );
+  int * j = util_malloc( active_size * sizeof * j );
+  int * k = util_malloc( active_size * sizeof * k );
+  double * volume = util_malloc( active_size * sizeof * volume );
+  double * x = util_malloc( active_size * sizeof * x );
+  double * y = util_malloc( active_size * sizeof * y );
+  double * z = util_malloc( active_size * sizeof * z );
+  double * depth = util_malloc( active_size * sizeof * depth );
+
+  ecl_grid_export_index( grid , global_index , i , j , k );
+  ecl_grid_export_volume( grid , volume );
+  ecl_grid_export_position( grid , x , y , z );
+  ecl_grid_export_position( grid , NULL , NULL , depth );
+
+  for (int active_index = 0; active_index < active_size; active_index++) {
+    double xpos, ypos, zpos;
+    int g = ecl_grid_get_global_index1A( grid , active_index );
+
+    test_assert_int_equal( g , global_index[ active_index ]);
+    test_assert_int_equal( g , ecl_grid_get_global_index3( grid , i[active_index] , j[active_index] , k[active_index]));
+    test_assert_double_equal( ecl_grid_get_cell_volume1( grid , g ) , volume[ active_index ]);
+
+    ecl_grid_get_xyz1( grid , g , &xpos , &ypos , &zpos );
+    test_assert_double_equal( xpos , x[ active_index ]);
+    test_assert_double_equal( ypos , y[ active_index ]);
+    test_assert_double_equal( zpos , z[ active_index ]);
+    test_assert_double_equal( ecl_grid_get_cdepth1( grid , g ) , depth[ active_index ]);
+  }
+
+  free( global_index );
+  free( i );
+  free( j );
+  free( k );
+  free( volume );
+  free( x );
+  free( y );
+  free( z );
+  free( depth );
+}
+
+
+
 int main(int argc , char ** argv) {
   test_work_area_type * work_area = test_work_area_alloc("grid_export");
   {
@@ -174,6 +219,7 @@ int main(int argc , char ** argv) {
       export_coord( ecl_grid , ecl_file );
       export_zcorn( ecl_grid , ecl_file );
       export_mapaxes( ecl_grid , ecl_file );
+      export_cell_data( ecl_grid );
       copy_processed( ecl_grid );
       ecl_file_close( ecl_file );
       ecl_grid_free( ecl_grid );
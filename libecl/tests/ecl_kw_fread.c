@@ -75,8 +75,62 @@ void test_fread_alloc() {
 }
 
 
+/*
+  The data is written as one large record, i.e. not with the standard
+  block layout; reading must fall back to the record-by-record reader.
+*/
+void test_nonstandard_blocks() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fread_blocks" );
+  {
+    ecl_kw_type * kw1 = ecl_kw_alloc( "DOUBLE" , 2500 , ECL_DOUBLE );
+    int i;
+    for (i=0; i < 2500; i++)
+      ecl_kw_iset_double( kw1 , i , i * 0.5 );
+
+    {
+      fortio_type * fortio = fortio_open_writer("DOUBLE" , false , true );
+      ecl_kw_fwrite( kw1 , fortio );
+      fortio_fclose( fortio );
+    }
+    {
+      fortio_type * fortio = fortio_open_reader("DOUBLE" , false , true );
+      ecl_kw_type * kw2 = ecl_kw_fread_alloc( fortio );
+      test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+      ecl_kw_free( kw2 );
+      fortio_fclose( fortio );
+    }
+
+    {
+      fortio_type * fortio = fortio_open_writer("ONE_RECORD" , false , true );
+      double * data = util_calloc( 2500 , sizeof * data );
+      ecl_kw_fwrite_header( kw1 , fortio );
+      for (i=0; i < 2500; i++)
+        data[i] = i * 0.5;
+      util_endian_flip_vector( data , sizeof * data , 2500 );
+      fortio_fwrite_record( fortio , (const char *) data , 2500 * sizeof * data );
+      ecl_kw_fwrite( kw1 , fortio );
+      fortio_fclose( fortio );
+      free( data );
+    }
+    {
+      fortio_type * fortio = fortio_open_reader("ONE_RECORD" , false , true );
+      ecl_kw_type * kw2 = ecl_kw_fread_alloc( fortio );
+      ecl_kw_type * kw3 = ecl_kw_fread_alloc( fortio );
+      test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+      test_assert_true( ecl_kw_equal( kw1 , kw3 ));
+      ecl_kw_free( kw2 );
+      ecl_kw_free( kw3 );
+      fortio_fclose( fortio );
+    }
+    ecl_kw_free( kw1 );
+  }
+  test_work_area_free( work_area );
+}
+
+
 int main(int argc , char ** argv) {
   test_fread_alloc();
+  test_nonstandard_blocks();
   exit(0);
 }
 
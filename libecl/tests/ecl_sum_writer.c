@@ -20,10 +20,12 @@
 
 #include <ert/util/test_util.h>
 #include <ert/util/time_t_vector.h>
+#include <ert/util/double_vector.h>
 #include <ert/util/util.h>
 #include <ert/util/test_work_area.h>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
 #include <ert/ecl/ecl_grid.h>
 
 
@@ -96,6 +98,25 @@ void test_write_read( ) {
       ecl_grid_free( grid );
     }
 
+    /* Data - vector and point access should agree. */
+    {
+      int params_index = ecl_sum_get_general_var_params_index( ecl_sum , "BPR:567" );
+      double_vector_type * data = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+      double sim_seconds = 0;
+
+      test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) + 1 , double_vector_size( data ));
+      for (int time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++) {
+        test_assert_double_equal( 10*sim_seconds , double_vector_iget( data , time_index + 1 ));
+        test_assert_double_equal( 10*sim_seconds , ecl_sum_iget( ecl_sum , time_index , params_index ));
+        test_assert_double_equal( 10*sim_seconds , ecl_sum_get_general_var( ecl_sum , time_index , "BPR:567" ));
+        sim_seconds += ministep_length;
+      }
+
+      ecl_sum_scale_vector( ecl_sum , params_index , 0.5 );
+      test_assert_double_equal( 5*ministep_length , ecl_sum_iget( ecl_sum , 1 , params_index ));
+      double_vector_free( data );
+    }
+
     ecl_sum_free( ecl_sum );
     test_work_area_free( work_area );
   }
@@ -103,7 +124,104 @@ void test_write_read( ) {
 
 
 
+void test_lazy_load( ) {
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  test_work_area_type * work_area = test_work_area_alloc("sum/lazy");
+  write_summary( "CASE" , start_time , 10 , 11 , 12 , 5 , 10 , 36000 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    ecl_sum_type * lazy_sum = ecl_sum_fread_alloc_case_lazy( "CASE" , ":" );
+    const char * keys[3] = {"FOPT" , "BPR:567" , "WWCT:OP-1"};
+
+    test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) , ecl_sum_get_data_length( lazy_sum ));
+    test_assert_time_t_equal( ecl_sum_get_end_time( ecl_sum ) , ecl_sum_get_end_time( lazy_sum ));
+    for (int ikey = 0; ikey < 3; ikey++) {
+      int params_index = ecl_sum_get_general_var_params_index( lazy_sum , keys[ikey] );
+      for (int time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++)
+        test_assert_double_equal( ecl_sum_iget( ecl_sum , time_index , params_index ) , ecl_sum_iget( lazy_sum , time_index , params_index ));
+    }
+
+    /* Writing the lazy case will load all the data. */
+    ecl_sum_set_case( lazy_sum , "COPY" );
+    ecl_sum_fwrite( lazy_sum );
+    ecl_sum_free( lazy_sum );
+    {
+      ecl_sum_type * copy = ecl_sum_fread_alloc_case( "COPY" , ":" );
+      int params_index = ecl_sum_get_general_var_params_index( copy , "BPR:567" );
+      test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) , ecl_sum_get_data_length( copy ));
+      for (int time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++)
+        test_assert_double_equal( ecl_sum_iget( ecl_sum , time_index , params_index ) , ecl_sum_iget( copy , time_index , params_index ));
+      ecl_sum_free( copy );
+    }
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+
+void test_interp_matrix( ) {
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  test_work_area_type * work_area = test_work_area_alloc("sum/interp");
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( "CASE" , false , true , ":" , start_time , true , 10 , 10 , 10 );
+    smspec_node_type * fopr = ecl_sum_add_var( ecl_sum , "FOPR" , NULL , 0 , "SM3/DAY" , 0 );
+    smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "SM3" , 0 );
+    double sim_seconds = 0;
+
+    for (int step = 0; step < 40; step++) {
+      ecl_sum_tstep_type * tstep;
+      sim_seconds += 3600 * (1 + step % 7);
+      tstep = ecl_sum_add_tstep( ecl_sum , 1 + step / 10 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopr , step % 5 );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds / 3600 );
+    }
+    ecl_sum_fwrite( ecl_sum );
+    ecl_sum_free( ecl_sum );
+  }
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+    time_t_vector_type * sim_times = time_t_vector_alloc( 0 , 0 );
+    time_t data_start = ecl_sum_get_data_start( ecl_sum );
+    time_t end_time = ecl_sum_get_end_time( ecl_sum );
+    double * values;
+    int num_times;
+
+    ecl_sum_vector_add_key( keylist , "FOPR" );
+    ecl_sum_vector_add_key( keylist , "FOPT" );
+
+    time_t_vector_append( sim_times , start_time - 3600 );
+    for (time_t t = data_start; t <= end_time; t += 1800)
+      time_t_vector_append( sim_times , t );
+    time_t_vector_append( sim_times , end_time );
+    time_t_vector_append( sim_times , end_time + 3600 );
+    num_times = time_t_vector_size( sim_times );
+
+    values = util_calloc( 2 * num_times , sizeof * values );
+    ecl_sum_init_interp_matrix( ecl_sum , sim_times , keylist , -1 , values );
+
+    test_assert_double_equal( -1 , values[0] );
+    test_assert_double_equal( -1 , values[num_times + num_times - 1] );
+    for (int itime = 1; itime < num_times - 1; itime++) {
+      time_t t = time_t_vector_iget( sim_times , itime );
+      test_assert_double_equal( ecl_sum_get_general_var_from_sim_time( ecl_sum , t , "FOPR" ) , values[itime] );
+      test_assert_double_equal( ecl_sum_get_general_var_from_sim_time( ecl_sum , t , "FOPT" ) , values[num_times + itime] );
+    }
+
+    free( values );
+    time_t_vector_free( sim_times );
+    ecl_sum_vector_free( keylist );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+
 int main( int argc , char ** argv) {
   test_write_read();
+  test_lazy_load();
+  test_interp_matrix();
   exit(0);
 }
@@ -26,6 +26,18 @@ add_executable( ecl_kw_fread ecl_kw_fread.c )
 target_link_libraries( ecl_kw_fread ecl  )
 add_test( ecl_kw_fread ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fread  )
 
+add_executable( ecl_file_mmap ecl_file_mmap.c )
+target_link_libraries( ecl_file_mmap ecl  )
+add_test( ecl_file_mmap ${EXECUTABLE_OUTPUT_PATH}/ecl_file_mmap  )
+
+add_executable( ecl_file_index ecl_file_index.c )
+target_link_libraries( ecl_file_index ecl  )
+add_test( ecl_file_index ${EXECUTABLE_OUTPUT_PATH}/ecl_file_index  )
+
+add_executable( ecl_file_restart_subset ecl_file_restart_subset.c )
+target_link_libraries( ecl_file_restart_subset ecl  )
+add_test( ecl_file_restart_subset ${EXECUTABLE_OUTPUT_PATH}/ecl_file_restart_subset  )
+
 add_executable( ecl_valid_basename ecl_valid_basename.c )
 target_link_libraries( ecl_valid_basename ecl  )
 add_test( ecl_valid_basename ${EXECUTABLE_OUTPUT_PATH}/ecl_valid_basename)
@@ -66,6 +78,10 @@ add_executable( ecl_kw_grdecl ecl_kw_grdecl.c )
 target_link_libraries( ecl_kw_grdecl ecl  )
 add_test( ecl_kw_grdecl ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_grdecl )
 
+add_executable( ecl_fscanf ecl_fscanf.c )
+target_link_libraries( ecl_fscanf ecl  )
+add_test( ecl_fscanf ${EXECUTABLE_OUTPUT_PATH}/ecl_fscanf )
+
 add_executable( ecl_kw_equal ecl_kw_equal.c )
 target_link_libraries( ecl_kw_equal ecl  )
 add_test( ecl_kw_equal ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_equal )
@@ -324,10 +324,29 @@ void well_info_add_UNRST_wells( well_info_type * well_info , ecl_file_type * rst
    have crash and burn.
 */
 
+/*
+   Only the well related keywords are indexed when the restart file is
+   opened; the restart header keywords are always included by
+   ecl_file_open_restart_subset().
+*/
+
 void well_info_load_rstfile( well_info_type * well_info , const char * filename, bool load_segment_information) {
-  ecl_file_type * ecl_file = ecl_file_open( filename , 0);
-  well_info_load_rst_eclfile(well_info, ecl_file, load_segment_information);
-  ecl_file_close( ecl_file );
+  stringlist_type * well_keywords = stringlist_alloc_new();
+  stringlist_append_ref( well_keywords , IWEL_KW );
+  stringlist_append_ref( well_keywords , ZWEL_KW );
+  stringlist_append_ref( well_keywords , XWEL_KW );
+  stringlist_append_ref( well_keywords , ICON_KW );
+  stringlist_append_ref( well_keywords , SCON_KW );
+  stringlist_append_ref( well_keywords , XCON_KW );
+  stringlist_append_ref( well_keywords , ISEG_KW );
+  stringlist_append_ref( well_keywords , RSEG_KW );
+  stringlist_append_ref( well_keywords , LGR_KW );
+  {
+    ecl_file_type * ecl_file = ecl_file_open_restart_subset( filename , well_keywords , NULL , 0);
+    well_info_load_rst_eclfile(well_info, ecl_file, load_segment_information);
+    ecl_file_close( ecl_file );
+  }
+  stringlist_free( well_keywords );
 }
 
 
@@ -86,6 +86,8 @@ void                   analysis_config_set_penalised_press( analysis_config_type
 void                   analysis_config_set_log_path(analysis_config_type * config , const char * log_path );
 void                   analysis_config_set_std_cutoff( analysis_config_type * config , double std_cutoff );
 double                 analysis_config_get_std_cutoff( const analysis_config_type * config );
+void                   analysis_config_set_stream_chunk_size( analysis_config_type * config , int chunk_size );
+int                    analysis_config_get_stream_chunk_size( const analysis_config_type * config );
 void                   analysis_config_add_config_items( config_parser_type * config );
 void                   analysis_config_fprintf_config( analysis_config_type * config , FILE * stream);
 
@@ -110,6 +110,7 @@ extern "C" {
 #define  MAX_RUNNING_LSF_KEY               "MAX_RUNNING_LSF"
 #define  MAX_RUNNING_RSH_KEY               "MAX_RUNNING_RSH"
 #define  MAX_SUBMIT_KEY                    "MAX_SUBMIT"
+#define  MAX_THREADS_KEY                   "MAX_THREADS"
 #define  NUM_REALIZATIONS_KEY              "NUM_REALIZATIONS"
 #define  MIN_REALIZATIONS_KEY              "MIN_REALIZATIONS"
 #define  OBS_CONFIG_KEY                    "OBS_CONFIG"
@@ -106,6 +106,7 @@
 #define DEFAULT_ENKF_TRUNCATION            0.99
 #define DEFAULT_ENKF_ALPHA                 3.0
 #define DEFAULT_ENKF_STD_CUTOFF            1e-6
+#define DEFAULT_UPDATE_STREAM_CHUNK_SIZE   0     /* 0: Serialize the complete dataset in one matrix. */
 #define DEFAULT_MERGE_OBSERVATIONS         false
 #define DEFAULT_RERUN                      false
 #define DEFAULT_RERUN_START                0  
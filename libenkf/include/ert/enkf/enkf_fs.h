@@ -38,6 +38,7 @@ extern "C" {
 #include <ert/enkf/state_map.h>
 #include <ert/enkf/misfit_ensemble_typedef.h>
 #include <ert/enkf/summary_key_set.h>
+#include <ert/enkf/summary_ens_store.h>
 #include <ert/enkf/custom_kw_config_set.h>
 
   const      char * enkf_fs_get_mount_point( const enkf_fs_type * fs );
@@ -45,6 +46,8 @@ extern "C" {
   const      char * enkf_fs_get_case_name( const enkf_fs_type * fs );
   bool              enkf_fs_is_read_only(const enkf_fs_type * fs);
   void              enkf_fs_fsync( enkf_fs_type * fs );
+  void              enkf_fs_begin_batch( enkf_fs_type * fs , int iens );
+  void              enkf_fs_commit_batch( enkf_fs_type * fs , int iens );
   void              enkf_fs_add_index_node(enkf_fs_type *  , int , int , const char * , enkf_var_type, ert_impl_type);
   
   enkf_fs_type    * enkf_fs_get_ref( enkf_fs_type * fs );
@@ -106,6 +109,7 @@ extern "C" {
   cases_config_type         * enkf_fs_get_cases_config( const enkf_fs_type * fs);
   misfit_ensemble_type      * enkf_fs_get_misfit_ensemble( const enkf_fs_type * fs );
   summary_key_set_type      * enkf_fs_get_summary_key_set( const enkf_fs_type * fs );
+  summary_ens_store_type    * enkf_fs_get_summary_ens_store( const enkf_fs_type * fs );
   custom_kw_config_set_type * enkf_fs_get_custom_kw_config_set( const enkf_fs_type * fs );
 
   void             enkf_fs_increase_write_count(enkf_fs_type * fs);
@@ -49,6 +49,7 @@ extern "C" {
   int                         forward_load_context_get_load_step(const forward_load_context_type * load_context);
   enkf_fs_type              * forward_load_context_get_result_fs( const forward_load_context_type * load_context );
   bool                        forward_load_context_load_restart_file( forward_load_context_type * load_context , int report_step );
+  void                        forward_load_context_select_restart_keywords( forward_load_context_type * load_context , const stringlist_type * restart_keywords);
   void                        forward_load_context_select_step( forward_load_context_type * load_context , int report_step);
 
   UTIL_IS_INSTANCE_HEADER( forward_load_context );
@@ -175,6 +175,7 @@ extern "C" {
   
   typedef void (fsync_driver_ftype) (void * driver);
   typedef void (free_driver_ftype)  (void * driver);
+  typedef void (batch_driver_ftype) (void * driver , int iens);
 
 
 /**
@@ -209,6 +210,8 @@ has_vector_ftype          * has_vector;    \
 unlink_vector_ftype       * unlink_vector; \
 free_driver_ftype         * free_driver;   \
 fsync_driver_ftype        * fsync_driver;  \
+batch_driver_ftype        * begin_batch;   \
+batch_driver_ftype        * commit_batch;  \
 int                         type_id
 
 
@@ -98,6 +98,8 @@ typedef struct site_config_struct site_config_type;
 
   void                     site_config_set_umask( site_config_type * site_config , mode_t umask);
   mode_t                   site_config_get_umask( const site_config_type * site_config );
+  void                     site_config_set_max_threads( site_config_type * site_config , int max_threads );
+  int                      site_config_get_max_threads( const site_config_type * site_config );
 
   site_config_type       * site_config_alloc_empty();
   void                     site_config_add_config_items( config_parser_type * config , bool site_mode);
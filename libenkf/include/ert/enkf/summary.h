@@ -35,6 +35,7 @@
 double    summary_get(const summary_type * summary, int report_step );
 bool      summary_active_value( double value );
 int       summary_length(const summary_type * summary);
+const double_vector_type * summary_get_data_vector(const summary_type * summary);
 
 VOID_HAS_DATA_HEADER(summary);
 UTIL_SAFE_CAST_HEADER(summary);
@@ -0,0 +1,48 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'summary_ens_store.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_ENS_STORE_H
+#define ERT_SUMMARY_ENS_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include <ert/util/type_macros.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/matrix.h>
+
+  typedef struct summary_ens_store_struct summary_ens_store_type;
+
+  summary_ens_store_type * summary_ens_store_alloc( const char * path , bool read_only );
+  void                     summary_ens_store_free( summary_ens_store_type * store );
+  const char             * summary_ens_store_get_path( const summary_ens_store_type * store );
+  bool                     summary_ens_store_is_read_only( const summary_ens_store_type * store );
+  bool                     summary_ens_store_has_key( const summary_ens_store_type * store , const char * key );
+  void                     summary_ens_store_fwrite_row( summary_ens_store_type * store , const char * key , int iens , const double_vector_type * data );
+  bool                     summary_ens_store_fread_key( summary_ens_store_type * store , const char * key , matrix_type * data , int_vector_type * length );
+
+  UTIL_IS_INSTANCE_HEADER( summary_ens_store );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -98,6 +98,34 @@ active_list_type * active_list_alloc_copy( const active_list_type * src) {
 }
 
 
+/**
+   Will allocate a new PARTLY_ACTIVE list consisting of the @size
+   active elements starting at active element number @offset in
+   @src; i.e. the serialized rows [offset, offset + size) of the
+   node. This is used to split large nodes when the update is
+   performed in chunks.
+*/
+
+active_list_type * active_list_alloc_slice( const active_list_type * src , int offset , int size) {
+  active_list_type * slice = active_list_alloc( );
+  slice->mode = PARTLY_ACTIVE;
+
+  if (src->mode == ALL_ACTIVE) {
+    for (int i = 0; i < size; i++)
+      int_vector_append( slice->index_list , offset + i );
+  } else if (src->mode == PARTLY_ACTIVE) {
+    if (offset + size > int_vector_size( src->index_list ))
+      util_abort("%s: slice [%d,%d) out of range - active size:%d \n",__func__ , offset , offset + size , int_vector_size( src->index_list ));
+
+    for (int i = 0; i < size; i++)
+      int_vector_append( slice->index_list , int_vector_iget( src->index_list , offset + i ));
+  } else
+    util_abort("%s: can not slice an INACTIVE list \n",__func__);
+
+  return slice;
+}
+
+
 void active_list_copy( active_list_type * target , const active_list_type * src) {
   target->mode = src->mode;
   int_vector_memcpy( target->index_list , src->index_list);
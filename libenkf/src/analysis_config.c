@@ -41,6 +41,7 @@
 
 #define UPDATE_OVERLAP_KEY      "OVERLAP_LIMIT"
 #define UPDATE_STD_CUTOFF_KEY   "STD_CUTOFF"
+#define UPDATE_STREAM_CHUNK_SIZE_KEY "STREAM_CHUNK_SIZE"
 
 
 #define ANALYSIS_CONFIG_TYPE_ID 64431306
@@ -222,6 +223,20 @@ double analysis_config_get_std_cutoff(const analysis_config_type * config) {
   return config_settings_get_double_value(config->update_settings, UPDATE_STD_CUTOFF_KEY);
 }
 
+/*
+  The maximum number of parameter rows which are serialized at a time
+  in the update; when this is <= 0 the full dataset is serialized in
+  one matrix.
+*/
+
+void analysis_config_set_stream_chunk_size( analysis_config_type * config , int chunk_size ) {
+  config_settings_set_int_value(config->update_settings, UPDATE_STREAM_CHUNK_SIZE_KEY, chunk_size );
+}
+
+int analysis_config_get_stream_chunk_size(const analysis_config_type * config) {
+  return config_settings_get_int_value(config->update_settings, UPDATE_STREAM_CHUNK_SIZE_KEY);
+}
+
 
 void analysis_config_set_log_path(analysis_config_type * config , const char * log_path ) {
   config->log_path        = util_realloc_string_copy(config->log_path , log_path);
@@ -599,6 +614,7 @@ analysis_config_type * analysis_config_alloc( rng_type * rng ) {
   config->update_settings           = config_settings_alloc( UPDATE_SETTING_KEY );
   config_settings_add_double_setting(config->update_settings, UPDATE_OVERLAP_KEY , DEFAULT_ENKF_ALPHA);
   config_settings_add_double_setting(config->update_settings, UPDATE_STD_CUTOFF_KEY, DEFAULT_ENKF_STD_CUTOFF );
+  config_settings_add_int_setting(config->update_settings, UPDATE_STREAM_CHUNK_SIZE_KEY, DEFAULT_UPDATE_STREAM_CHUNK_SIZE );
 
   analysis_config_set_merge_observations( config       , DEFAULT_MERGE_OBSERVATIONS );
   analysis_config_set_rerun( config                    , DEFAULT_RERUN );
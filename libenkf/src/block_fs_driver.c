@@ -371,7 +371,7 @@ void block_fs_driver_free(void *_driver) {
   block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
   {
     int driver_nr;
-    thread_pool_type * tp         = thread_pool_alloc( 4 , true);
+    thread_pool_type * tp         = thread_pool_alloc( thread_pool_get_default_size( driver->num_fs ) , true);
     for (driver_nr = 0; driver_nr < driver->num_fs; driver_nr++) 
       thread_pool_add_job( tp , bfs_close__ , driver->fs_list[driver_nr] );
 
@@ -398,6 +398,25 @@ static void block_fs_driver_fsync( void * _driver ) {
 }
 
 
+/*
+  The batch functions only apply to the block_fs instance which holds
+  realization @iens.
+*/
+
+static void block_fs_driver_begin_batch( void * _driver , int iens ) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
+  block_fs_begin_batch( bfs->block_fs );
+}
+
+
+static void block_fs_driver_commit_batch( void * _driver , int iens ) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
+  block_fs_commit_batch( bfs->block_fs );
+}
+
+
 static block_fs_driver_type * block_fs_driver_alloc(int num_fs) {
   block_fs_driver_type * driver = util_malloc(sizeof * driver );
   {
@@ -416,6 +435,8 @@ static block_fs_driver_type * block_fs_driver_alloc(int num_fs) {
 
   driver->free_driver   = block_fs_driver_free;
   driver->fsync_driver  = block_fs_driver_fsync;
+  driver->begin_batch   = block_fs_driver_begin_batch;
+  driver->commit_batch  = block_fs_driver_commit_batch;
   driver->__id          = BLOCK_FS_DRIVER_ID;
   driver->num_fs        = num_fs;
 
@@ -438,7 +459,7 @@ static void * block_fs_driver_alloc_new( fs_driver_enum driver_type , bool read_
 
 
 static void block_fs_driver_mount( block_fs_driver_type * driver ) {
-  thread_pool_type * tp = thread_pool_alloc( 4 , true ); 
+  thread_pool_type * tp = thread_pool_alloc( thread_pool_get_default_size( driver->num_fs ) , true );
 
   for (int ifs = 0; ifs < driver->num_fs; ifs++)
     thread_pool_add_job( tp , bfs_mount__ , driver->fs_list[ ifs ]);
@@ -44,6 +44,7 @@
 #include <ert/enkf/time_map.h>
 #include <ert/enkf/state_map.h>
 #include <ert/enkf/summary_key_set.h>
+#include <ert/enkf/summary_ens_store.h>
 #include <ert/enkf/misfit_ensemble.h>
 #include <ert/enkf/cases_config.h>
 #include <ert/enkf/custom_kw_config_set.h>
@@ -207,6 +208,7 @@
 #define ENKF_FS_TYPE_ID           1089763
 #define ENKF_MOUNT_MAP            "enkf_mount_info"
 #define SUMMARY_KEY_SET_FILE      "summary-key-set"
+#define SUMMARY_ENS_STORE_PATH    "summary-ensemble"
 #define TIME_MAP_FILE             "time-map"
 #define STATE_MAP_FILE            "state-map"
 #define MISFIT_ENSEMBLE_FILE      "misfit-ensemble"
@@ -231,6 +233,7 @@ struct enkf_fs_struct {
   cases_config_type         * cases_config;
   state_map_type            * state_map;
   summary_key_set_type      * summary_key_set;
+  summary_ens_store_type    * summary_ens_store;
   misfit_ensemble_type      * misfit_ensemble;
   custom_kw_config_set_type * custom_kw_config_set;
   /*
@@ -325,6 +328,13 @@ static enkf_fs_type * enkf_fs_alloc_empty( const char * mount_point ) {
 
     util_free_stringlist( path_tmp , path_len );
   }
+  {
+    char * case_path = util_alloc_sprintf( DEFAULT_CASE_PATH , fs->mount_point );
+    char * store_path = util_alloc_filename( case_path , SUMMARY_ENS_STORE_PATH , NULL );
+    fs->summary_ens_store = summary_ens_store_alloc( store_path , fs->read_only );
+    free( store_path );
+    free( case_path );
+  }
   return fs;
 }
 
@@ -738,6 +748,7 @@ static void enkf_fs_umount( enkf_fs_type * fs ) {
       custom_kw_config_set_free( fs->custom_kw_config_set );
       state_map_free( fs->state_map );
       summary_key_set_free(fs->summary_key_set);
+      summary_ens_store_free( fs->summary_ens_store );
       time_map_free( fs->time_map );
       cases_config_free( fs->cases_config );
       misfit_ensemble_free( fs->misfit_ensemble );
@@ -782,6 +793,46 @@ static void enkf_fs_fsync_driver( fs_driver_type * driver ) {
 
 
 
+/**
+   While a batch is open the nodes and vectors written for realization
+   @iens are kept in memory by the drivers which support it, and
+   written to disk with one fsync when the batch is committed. Reading
+   a node which has been written in the batch will return the new
+   content. The batches must be balanced, i.e. every
+   enkf_fs_begin_batch() must have a matching enkf_fs_commit_batch().
+*/
+
+static void enkf_fs_begin_batch_driver( fs_driver_type * driver , int iens ) {
+  if (driver->begin_batch != NULL)
+    driver->begin_batch( driver , iens );
+}
+
+
+static void enkf_fs_commit_batch_driver( fs_driver_type * driver , int iens ) {
+  if (driver->commit_batch != NULL)
+    driver->commit_batch( driver , iens );
+}
+
+
+void enkf_fs_begin_batch( enkf_fs_type * fs , int iens ) {
+  if (!fs->read_only) {
+    enkf_fs_begin_batch_driver( fs->parameter , iens );
+    enkf_fs_begin_batch_driver( fs->dynamic_forecast , iens );
+    enkf_fs_begin_batch_driver( fs->index , iens );
+  }
+}
+
+
+void enkf_fs_commit_batch( enkf_fs_type * fs , int iens ) {
+  if (!fs->read_only) {
+    enkf_fs_commit_batch_driver( fs->parameter , iens );
+    enkf_fs_commit_batch_driver( fs->dynamic_forecast , iens );
+    enkf_fs_commit_batch_driver( fs->index , iens );
+  }
+}
+
+
+
 void enkf_fs_fsync( enkf_fs_type * fs ) {
   enkf_fs_fsync_driver( fs->parameter );
   enkf_fs_fsync_driver( fs->dynamic_forecast );
@@ -1036,6 +1087,10 @@ summary_key_set_type * enkf_fs_get_summary_key_set( const enkf_fs_type * fs ) {
   return fs->summary_key_set;
 }
 
+summary_ens_store_type * enkf_fs_get_summary_ens_store( const enkf_fs_type * fs ) {
+  return fs->summary_ens_store;
+}
+
 custom_kw_config_set_type * enkf_fs_get_custom_kw_config_set(const enkf_fs_type * fs) {
   return fs->custom_kw_config_set;
 }
@@ -47,6 +47,7 @@
 #include <ert/util/node_ctype.h>
 #include <ert/util/string_util.h>
 #include <ert/util/type_vector_functions.h>
+#include <ert/util/vector.h>
 
 #include <ert/config/config_parser.h>
 #include <ert/config/config_schema_item.h>
@@ -698,24 +699,38 @@ static void * serialize_nodes_mt( void * arg ) {
 }
 
 
-static void enkf_main_serialize_node( const char * node_key ,
-                                      const active_list_type * active_list ,
-                                      int row_offset ,
-                                      thread_pool_type * work_pool ,
-                                      serialize_info_type * serialize_info) {
+/*
+  The (de)serialization of a dataset is organized as one list of
+  jobs, where each job handles one node key for one slice of
+  realizations. All the jobs of a dataset are added to the thread
+  pool before it is joined, so that the threads are kept busy across
+  node keys, and a node key with large or slow nodes does not stall
+  the other keys. The serialize_info argument holds the realization
+  slices; one job is added for each slice.
+*/
 
-  /* Multithreaded serializing*/
-  const int num_cpu_threads = thread_pool_get_max_running( work_pool );
-  int icpu;
+static void enkf_main_add_node_jobs( vector_type * jobs ,
+                                     const char * node_key ,
+                                     const active_list_type * active_list ,
+                                     int row_offset ,
+                                     int num_slices ,
+                                     const serialize_info_type * serialize_info) {
+  for (int islice = 0; islice < num_slices; islice++) {
+    serialize_info_type * job = util_alloc_copy( &serialize_info[islice] , sizeof * job );
+    job->key         = node_key;
+    job->active_list = active_list;
+    job->row_offset  = row_offset;
+    vector_append_owned_ref( jobs , job , free );
+  }
+}
 
-  thread_pool_restart( work_pool );
-  for (icpu = 0; icpu < num_cpu_threads; icpu++) {
-    serialize_info[icpu].key         = node_key;
-    serialize_info[icpu].active_list = active_list;
-    serialize_info[icpu].row_offset  = row_offset;
 
-    thread_pool_add_job( work_pool , serialize_nodes_mt , &serialize_info[icpu]);
-  }
+static void enkf_main_run_node_jobs( const vector_type * jobs ,
+                                     thread_pool_type * work_pool ,
+                                     void * (*job_func) (void *)) {
+  thread_pool_restart( work_pool );
+  for (int i = 0; i < vector_get_size( jobs ); i++)
+    thread_pool_add_job( work_pool , job_func , vector_iget( jobs , i ));
   thread_pool_join( work_pool );
 }
 
@@ -737,6 +752,7 @@ static int enkf_main_serialize_dataset( const ensemble_config_type * ens_config
 
   matrix_type * A   = serialize_info->A;
   stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+  vector_type * jobs = vector_alloc_new( );
   const int num_kw  = stringlist_get_size( update_keys );
   int ens_size      = matrix_get_columns( A );
   int current_row   = 0;
@@ -756,19 +772,26 @@ static int enkf_main_serialize_dataset( const ensemble_config_type * ens_config
       active_size[ikw] = __get_active_size( ens_config , src_fs , key , report_step , active_list );
       row_offset[ikw]  = current_row;
 
-      {
-        int matrix_rows = matrix_get_rows( A );
-        if ((active_size[ikw] + current_row) > matrix_rows)
-          matrix_resize( A , matrix_rows + 2 * active_size[ikw] , ens_size , true );
-      }
-
       if (active_size[ikw] > 0) {
-        enkf_main_serialize_node( key , active_list , row_offset[ikw] , work_pool , serialize_info );
+        enkf_main_add_node_jobs( jobs , key , active_list , row_offset[ikw] , thread_pool_get_max_running( work_pool ) , serialize_info );
         current_row += active_size[ikw];
       }
     }
   }
+
+  /*
+    The A matrix must have its final size before the jobs are started,
+    the jobs write directly into the storage of A.
+  */
+  {
+    int matrix_rows = matrix_get_rows( A );
+    if (current_row > matrix_rows)
+      matrix_resize( A , current_row , ens_size , false );
+  }
+  enkf_main_run_node_jobs( jobs , work_pool , serialize_nodes_mt );
+
   matrix_shrink_header( A , current_row , ens_size );
+  vector_free( jobs );
   stringlist_free( update_keys );
   return matrix_get_rows( A );
 }
@@ -810,8 +833,8 @@ static void enkf_main_deserialize_dataset( ensemble_config_type * ensemble_confi
                                            serialize_info_type * serialize_info ,
                                            thread_pool_type * work_pool ) {
 
-  int num_cpu_threads = thread_pool_get_max_running( work_pool );
   stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+  vector_type * jobs = vector_alloc_new( );
   for (int i = 0; i < stringlist_get_size( update_keys ); i++) {
     const char             * key         = stringlist_iget(update_keys , i);
     enkf_config_node_type * config_node  = ensemble_config_get_node( ensemble_config , key );
@@ -825,23 +848,12 @@ static void enkf_main_deserialize_dataset( ensemble_config_type * ensemble_confi
     else {
       if (active_size[i] > 0) {
         const active_list_type * active_list      = local_dataset_get_node_active_list( dataset , key );
-
-        {
-          /* Multithreaded */
-          int icpu;
-          thread_pool_restart( work_pool );
-          for (icpu = 0; icpu < num_cpu_threads; icpu++) {
-            serialize_info[icpu].key         = key;
-            serialize_info[icpu].active_list = active_list;
-            serialize_info[icpu].row_offset  = row_offset[i];
-
-            thread_pool_add_job( work_pool , deserialize_nodes_mt , &serialize_info[icpu]);
-          }
-          thread_pool_join( work_pool );
-        }
+        enkf_main_add_node_jobs( jobs , key , active_list , row_offset[i] , thread_pool_get_max_running( work_pool ) , serialize_info );
       }
     }
   }
+  enkf_main_run_node_jobs( jobs , work_pool , deserialize_nodes_mt );
+  vector_free( jobs );
   stringlist_free( update_keys );
 }
 
@@ -881,6 +893,205 @@ static serialize_info_type * serialize_info_alloc( enkf_fs_type * src_fs,
   return serialize_info;
 }
 
+/*****************************************************************/
+/*
+  Streaming update. When the UPDATE_SETTINGS STREAM_CHUNK_SIZE setting
+  is positive, and the analysis module computes an X matrix, the
+  parameters of a dataset are not serialized into one large A
+  matrix. Instead the dataset is split in chunks of at most chunk_size
+  rows; each chunk is serialized, multiplied with X and deserialized
+  in turn. Nodes which do not fit in the remaining part of a chunk are
+  split with active_list_alloc_slice().
+
+  Two chunk matrices are used, so that chunk k + 1 can be serialized
+  while chunk k is multiplied with X in a separate thread. Observe
+  that a node is loaded from storage for every chunk it is part of,
+  and that chunk k + 1 is serialized before chunk k is
+  deserialized. That is fine because deserialize only updates the rows
+  of the current chunk, and stores the node before the next chunk is
+  deserialized.
+*/
+
+typedef struct {
+  stringlist_type  * keys;
+  vector_type      * active_lists;   /* Either the active_list from the dataset, or a slice owned by the chunk. */
+  int_vector_type  * row_offset;
+  int                rows;
+} update_chunk_type;
+
+
+static update_chunk_type * update_chunk_alloc( ) {
+  update_chunk_type * chunk = util_malloc( sizeof * chunk );
+  chunk->keys         = stringlist_alloc_new( );
+  chunk->active_lists = vector_alloc_new( );
+  chunk->row_offset   = int_vector_alloc( 0 , 0 );
+  chunk->rows         = 0;
+  return chunk;
+}
+
+
+static void update_chunk_free( update_chunk_type * chunk ) {
+  stringlist_free( chunk->keys );
+  vector_free( chunk->active_lists );
+  int_vector_free( chunk->row_offset );
+  free( chunk );
+}
+
+
+static void update_chunk_free__( void * arg ) {
+  update_chunk_free( (update_chunk_type *) arg );
+}
+
+
+static void update_chunk_add_node( update_chunk_type * chunk , const char * key , const active_list_type * active_list , int rows , bool owned) {
+  stringlist_append_copy( chunk->keys , key );
+  if (owned)
+    vector_append_owned_ref( chunk->active_lists , active_list , active_list_free__ );
+  else
+    vector_append_ref( chunk->active_lists , active_list );
+  int_vector_append( chunk->row_offset , chunk->rows );
+  chunk->rows += rows;
+}
+
+
+static vector_type * enkf_main_alloc_update_chunks( const ensemble_config_type * ens_config ,
+                                                    const local_dataset_type * dataset ,
+                                                    enkf_fs_type * fs ,
+                                                    int report_step ,
+                                                    run_mode_type run_mode ,
+                                                    int chunk_size ) {
+  vector_type * chunks = vector_alloc_new( );
+  stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+  update_chunk_type * chunk = NULL;
+
+  for (int ikw=0; ikw < stringlist_get_size( update_keys ); ikw++) {
+    const char             * key         = stringlist_iget(update_keys , ikw);
+    enkf_config_node_type * config_node  = ensemble_config_get_node( ens_config , key );
+    if ((run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER))
+      continue;
+    {
+      const active_list_type * active_list = local_dataset_get_node_active_list( dataset , key );
+      int active_size = __get_active_size( ens_config , fs , key , report_step , active_list );
+      int node_row = 0;
+
+      while (node_row < active_size) {
+        int rows;
+        if ((chunk == NULL) || (chunk->rows == chunk_size)) {
+          chunk = update_chunk_alloc( );
+          vector_append_owned_ref( chunks , chunk , update_chunk_free__ );
+        }
+
+        rows = util_int_min( active_size - node_row , chunk_size - chunk->rows );
+        if (rows == active_size)
+          update_chunk_add_node( chunk , key , active_list , rows , false );
+        else
+          update_chunk_add_node( chunk , key , active_list_alloc_slice( active_list , node_row , rows ) , rows , true );
+
+        node_row += rows;
+      }
+    }
+  }
+
+  stringlist_free( update_keys );
+  return chunks;
+}
+
+
+static void enkf_main_serialize_chunk( const update_chunk_type * chunk ,
+                                       matrix_type * A ,
+                                       thread_pool_type * work_pool ,
+                                       serialize_info_type * serialize_info) {
+  vector_type * jobs = vector_alloc_new( );
+  matrix_full_size( A );
+  matrix_shrink_header( A , chunk->rows , matrix_get_columns( A ));
+  for (int i = 0; i < stringlist_get_size( chunk->keys ); i++)
+    enkf_main_add_node_jobs( jobs ,
+                             stringlist_iget( chunk->keys , i ) ,
+                             vector_iget_const( chunk->active_lists , i ) ,
+                             int_vector_iget( chunk->row_offset , i ) ,
+                             thread_pool_get_max_running( work_pool ) ,
+                             serialize_info );
+  enkf_main_run_node_jobs( jobs , work_pool , serialize_nodes_mt );
+  vector_free( jobs );
+}
+
+
+static void enkf_main_deserialize_chunk( const update_chunk_type * chunk ,
+                                         thread_pool_type * work_pool ,
+                                         serialize_info_type * serialize_info) {
+  vector_type * jobs = vector_alloc_new( );
+  for (int i = 0; i < stringlist_get_size( chunk->keys ); i++)
+    enkf_main_add_node_jobs( jobs ,
+                             stringlist_iget( chunk->keys , i ) ,
+                             vector_iget_const( chunk->active_lists , i ) ,
+                             int_vector_iget( chunk->row_offset , i ) ,
+                             thread_pool_get_max_running( work_pool ) ,
+                             serialize_info );
+  enkf_main_run_node_jobs( jobs , work_pool , deserialize_nodes_mt );
+  vector_free( jobs );
+}
+
+
+static void * enkf_main_matmul_chunk_mt( void * arg ) {
+  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
+  matrix_type * A          = arg_pack_iget_ptr( arg_pack , 0 );
+  const matrix_type * X    = arg_pack_iget_const_ptr( arg_pack , 1 );
+  thread_pool_type * tp    = arg_pack_iget_ptr( arg_pack , 2 );
+
+  matrix_inplace_matmul_mt2( A , X , tp );
+  return NULL;
+}
+
+
+/*
+  The A and serialize_info arguments are pairs of chunk matrices, with
+  corresponding serialize_info instances.
+*/
+
+static void enkf_main_stream_update_dataset( const ensemble_config_type * ens_config ,
+                                             const local_dataset_type * dataset ,
+                                             enkf_fs_type * fs ,
+                                             int report_step ,
+                                             run_mode_type run_mode ,
+                                             int chunk_size ,
+                                             const matrix_type * X ,
+                                             thread_pool_type * work_pool ,
+                                             thread_pool_type * matmul_pool ,
+                                             matrix_type ** A ,
+                                             serialize_info_type ** serialize_info) {
+
+  vector_type * chunks = enkf_main_alloc_update_chunks( ens_config , dataset , fs , report_step , run_mode , chunk_size );
+  int num_chunks = vector_get_size( chunks );
+  thread_pool_type * pipeline = thread_pool_alloc( 1 , false );
+  arg_pack_type * matmul_arg = arg_pack_alloc( );
+
+  if (num_chunks > 0)
+    enkf_main_serialize_chunk( vector_iget_const( chunks , 0 ) , A[0] , work_pool , serialize_info[0] );
+
+  for (int ichunk = 0; ichunk < num_chunks; ichunk++) {
+    int current = ichunk % 2;
+    int next    = 1 - current;
+
+    arg_pack_clear( matmul_arg );
+    arg_pack_append_ptr( matmul_arg , A[current] );
+    arg_pack_append_const_ptr( matmul_arg , X );
+    arg_pack_append_ptr( matmul_arg , matmul_pool );
+
+    thread_pool_restart( pipeline );
+    thread_pool_add_job( pipeline , enkf_main_matmul_chunk_mt , matmul_arg );
+    if (ichunk + 1 < num_chunks)
+      enkf_main_serialize_chunk( vector_iget_const( chunks , ichunk + 1 ) , A[next] , work_pool , serialize_info[next] );
+    thread_pool_join( pipeline );
+
+    enkf_main_deserialize_chunk( vector_iget_const( chunks , ichunk ) , work_pool , serialize_info[current] );
+  }
+
+  arg_pack_free( matmul_arg );
+  thread_pool_free( pipeline );
+  vector_free( chunks );
+}
+
+
 static module_info_type * enkf_main_module_info_alloc( const local_ministep_type* ministep,
                                                        const obs_data_type * obs_data,
                                                        const local_dataset_type * dataset ,
@@ -994,7 +1205,7 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                        const meas_data_type * forecast ,
                                        obs_data_type * obs_data) {
 
-  const int cpu_threads       = 4;
+  const int cpu_threads       = thread_pool_get_cpu_budget( );
   const int matrix_start_size = 250000;
   thread_pool_type * tp       = thread_pool_alloc( cpu_threads , false );
   int active_ens_size   = meas_data_get_active_ens_size( forecast );
@@ -1003,7 +1214,7 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
   matrix_type * S       = meas_data_allocS( forecast );
   matrix_type * R       = obs_data_allocR( obs_data );
   matrix_type * dObs    = obs_data_allocdObs( obs_data );
-  matrix_type * A       = matrix_alloc( matrix_start_size , active_ens_size );
+  matrix_type * A       = NULL;
   matrix_type * E       = NULL;
   matrix_type * D       = NULL;
   matrix_type * localA  = NULL;
@@ -1013,6 +1224,27 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
   if ( local_ministep_has_analysis_module (ministep))
     module = local_ministep_get_analysis_module (ministep);
 
+  int stream_chunk_size = analysis_config_get_stream_chunk_size( enkf_main->analysis_config );
+  bool stream_update    = (stream_chunk_size > 0) &&
+                          !analysis_module_check_option( module , ANALYSIS_USE_A) &&
+                          !analysis_module_check_option( module , ANALYSIS_UPDATE_A);
+
+  /*
+    In streaming mode the full A matrix is never assembled; the
+    matrices in stream_A hold one chunk each, and A is only allocated
+    as a placeholder for the serialize_info instance.
+  */
+  matrix_type * stream_A[2]                     = { NULL , NULL };
+  serialize_info_type * stream_serialize_info[2] = { NULL , NULL };
+  thread_pool_type * matmul_tp                   = NULL;
+  if (stream_update) {
+    A = matrix_alloc( 1 , active_ens_size );
+    for (int i = 0; i < 2; i++)
+      stream_A[i] = matrix_alloc( stream_chunk_size , active_ens_size );
+    matmul_tp = thread_pool_alloc( cpu_threads , false );
+  } else
+    A = matrix_alloc( matrix_start_size , active_ens_size );
+
   assert_matrix_size(X , "X" , active_ens_size , active_ens_size);
   assert_matrix_size(S , "S" , active_size , active_ens_size);
   assert_matrix_size(R , "R" , active_size , active_size);
@@ -1047,6 +1279,12 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                                                  A ,
                                                                  cpu_threads);
 
+    for (int i = 0; i < 2; i++) {
+      if (stream_A[i])
+        stream_serialize_info[i] = serialize_info_alloc( target_fs , target_fs , iens_active_index , target_step ,
+                                                         enkf_main_get_ensemble( enkf_main ) , run_mode , step2 ,
+                                                         stream_A[i] , cpu_threads );
+    }
 
     // Store PC:
     if (analysis_config_get_store_PC( enkf_main->analysis_config )) {
@@ -1080,7 +1318,10 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
     while (!hash_iter_is_complete( dataset_iter )) {
       const char * dataset_name = hash_iter_get_next_key( dataset_iter );
       const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
-      if (local_dataset_get_size( dataset )) {
+      if (stream_update) {
+        enkf_main_stream_update_dataset( enkf_main->ensemble_config , dataset , target_fs , step2 , run_mode ,
+                                         stream_chunk_size , X , tp , matmul_tp , stream_A , stream_serialize_info );
+      } else if (local_dataset_get_size( dataset )) {
         int * active_size = util_calloc( local_dataset_get_size( dataset ) , sizeof * active_size );
         int * row_offset  = util_calloc( local_dataset_get_size( dataset ) , sizeof * row_offset  );
         local_obsdata_type   * local_obsdata = local_ministep_get_obsdata( ministep );
@@ -1113,6 +1354,10 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
     }
     hash_iter_free( dataset_iter );
     serialize_info_free( serialize_info );
+    for (int i = 0; i < 2; i++) {
+      if (stream_serialize_info[i])
+        serialize_info_free( stream_serialize_info[i] );
+    }
   }
   analysis_module_complete_update( module );
 
@@ -1127,6 +1372,10 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
   matrix_free( dObs );
   matrix_free( X );
   matrix_free( A );
+  matrix_safe_free( stream_A[0] );
+  matrix_safe_free( stream_A[1] );
+  if (matmul_tp)
+    thread_pool_free( matmul_tp );
 }
 
 
@@ -1536,7 +1785,7 @@ void enkf_main_submit_jobs( enkf_main_type * enkf_main ,
 
   int ens_size = enkf_main_get_ensemble_size( enkf_main );
   arg_pack_type ** arg_pack_list = util_malloc( ens_size * sizeof * arg_pack_list );
-  thread_pool_type * submit_threads = thread_pool_alloc( 4 , true );
+  thread_pool_type * submit_threads = thread_pool_alloc( thread_pool_get_default_size( ens_size ) , true );
   runpath_list_type * runpath_list = hook_manager_get_runpath_list( enkf_main->hook_manager );
   int iens;
   for (iens = 0; iens < ens_size; iens++)
@@ -3111,7 +3360,7 @@ int enkf_main_load_from_forward_model_with_fs(enkf_main_type * enkf_main, int it
 
   ert_run_context_type * run_context = ert_run_context_alloc_ENSEMBLE_EXPERIMENT( fs , iactive , model_config_get_runpath_fmt( model_config ) , enkf_main->subst_list , iter );
   arg_pack_type ** arg_list = util_calloc( ens_size , sizeof * arg_list );
-  thread_pool_type * tp     = thread_pool_alloc( 4 , true );  /* num_cpu - HARD coded. */
+  thread_pool_type * tp     = thread_pool_alloc( thread_pool_get_default_size( ens_size ) , true );
 
   int iens = 0;
   for (; iens < ens_size; ++iens) {
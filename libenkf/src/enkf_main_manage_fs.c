@@ -121,8 +121,8 @@ static void * enkf_main_initialize_from_scratch_mt(void * void_arg) {
 }
 
 void enkf_main_initialize_from_scratch(enkf_main_type * enkf_main , enkf_fs_type * init_fs , const stringlist_type * param_list ,const bool_vector_type * iens_mask , init_mode_type init_mode) {
-  int num_cpu = 4;
   int ens_size               = enkf_main_get_ensemble_size( enkf_main );
+  int num_cpu                = thread_pool_get_default_size( ens_size );
   thread_pool_type * tp     = thread_pool_alloc( num_cpu , true );
   arg_pack_type ** arg_list = util_calloc( ens_size , sizeof * arg_list );
   int i;
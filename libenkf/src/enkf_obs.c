@@ -421,6 +421,16 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
 
     enkf_node_type  * work_node  = enkf_node_alloc( obs_vector_get_config_node( obs_vector ));
 
+    /*
+      The simulated values for all realizations are read from the
+      ensemble summary store in one go; realizations which are not in
+      the store, e.g. cases loaded before the store existed, are
+      loaded node by node.
+    */
+    matrix_type     * ens_data   = matrix_alloc( 1 , 1 );
+    int_vector_type * ens_length = int_vector_alloc( 0 , 0 );
+    summary_ens_store_fread_key( enkf_fs_get_summary_ens_store( fs ) , enkf_node_get_key( work_node ) , ens_data , ens_length );
+
     for (int i=0; i < active_count; i++)
       obs_block_iset( obs_block , i , double_vector_iget( obs_value , i) , double_vector_iget( obs_std , i ));
 
@@ -439,9 +449,12 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
           const int iens = int_vector_iget( ens_active_list , iens_index );
           node_id_type node_id = {.report_step = step,
                                   .iens        = iens};
-          enkf_node_load( work_node , fs , node_id );
+          int smlength   = int_vector_safe_iget( ens_length , iens );
+          if (smlength <= 0) {
+            enkf_node_load( work_node , fs , node_id );
+            smlength = summary_length( enkf_node_value_ptr( work_node ) );
+          }
 
-          int smlength   = summary_length( enkf_node_value_ptr( work_node ) );
           if (step >= smlength) {
             // if obs vector and sim vector have different length
             // deactivate and continue to next
@@ -450,7 +463,9 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
             obs_block_deactivate(obs_block , active_count, true, msg);
             free( msg );
             break;
-          } else {
+          } else if (int_vector_safe_iget( ens_length , iens ) > 0)
+            meas_block_iset(meas_block , iens , active_count , matrix_iget( ens_data , iens , step ));
+          else {
             meas_block_iset(meas_block , iens , active_count ,
                             summary_get( enkf_node_value_ptr( work_node ),
                                          node_id.report_step ));
@@ -459,6 +474,8 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
         active_count++;
       }
     }
+    int_vector_free( ens_length );
+    matrix_free( ens_data );
     enkf_node_free( work_node );
   }
 }
@@ -148,7 +148,7 @@ void enkf_plot_gendata_load( enkf_plot_gendata_type * plot_data ,
     enkf_plot_gendata_reset( plot_data , report_step );
 
     {
-      const int num_cpu = 4;
+      const int num_cpu = thread_pool_get_default_size( ens_size );
       thread_pool_type * tp = thread_pool_alloc( num_cpu , true );
       for (int iens = 0; iens < ens_size ; iens++) {
         if (bool_vector_iget( mask , iens)) {
@@ -604,6 +604,12 @@ static bool enkf_state_internalize_dynamic_eclipse_results(enkf_state_type * enk
 
         const ecl_smspec_type * smspec = ecl_sum_get_smspec(summary);
 
+        /*
+           One small vector is stored per summary key; the writes are batched to avoid per-write overhead in the storage.
+           The vectors are also written as this realization's row in the ensemble summary store, see summary_ens_store.c.
+        */
+        summary_ens_store_type * summary_ens_store = enkf_fs_get_summary_ens_store( result_fs );
+        enkf_fs_begin_batch( result_fs , iens );
         for(int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
             const smspec_node_type * smspec_node = ecl_smspec_iget_node(smspec, i);
             const char * key = smspec_node_get_gen_key1(smspec_node);
@@ -619,8 +625,10 @@ static bool enkf_state_internalize_dynamic_eclipse_results(enkf_state_type * enk
 
                 enkf_node_forward_load_vector( node , load_context , time_index);
                 enkf_node_store_vector( node , result_fs , iens );
+                summary_ens_store_fwrite_row( summary_ens_store , key , iens , summary_get_data_vector( enkf_node_value_ptr( node )));
             }
         }
+        enkf_fs_commit_batch( result_fs , iens );
 
         int_vector_free( time_index );
 
@@ -764,6 +772,27 @@ static void enkf_state_internalize_eclipse_state(enkf_state_type * enkf_state ,
     const int  iens                    = member_config_get_iens( my_config );
     const bool internalize_state       = model_config_internalize_state( model_config , report_step );
 
+    /*
+      Only the keywords of the dynamic FIELD nodes are loaded from
+      the restart file, so only those keywords are indexed when the
+      restart file is opened.
+    */
+    {
+      stringlist_type * restart_keywords = stringlist_alloc_new( );
+      hash_iter_type * iter = hash_iter_alloc(enkf_state->node_hash);
+      while ( !hash_iter_is_complete(iter) ) {
+        enkf_node_type * enkf_node = hash_iter_get_next_value(iter);
+        if (enkf_node_get_var_type(enkf_node) == DYNAMIC_STATE &&
+            enkf_node_get_impl_type(enkf_node) == FIELD) {
+          const field_config_type * field_config = enkf_config_node_get_ref( enkf_node_get_config( enkf_node ));
+          stringlist_append_copy( restart_keywords , field_config_get_key( field_config ));
+        }
+      }
+      hash_iter_free(iter);
+
+      forward_load_context_select_restart_keywords( load_context , restart_keywords );
+      stringlist_free( restart_keywords );
+    }
     forward_load_context_load_restart_file( load_context , report_step);
 
     /******************************************************************/
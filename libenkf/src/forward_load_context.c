@@ -40,6 +40,7 @@ struct forward_load_context_struct {
   int step1;
   int step2;
   stringlist_type * messages;          // This is managed by external scope - can be NULL
+  stringlist_type * restart_keywords;  // Can be NULL - then all keywords in the restart file are indexed.
 
 
   /* The variables below are updated during the load process. */
@@ -91,7 +92,7 @@ static void forward_load_context_load_ecl_sum(forward_load_context_type * load_c
     }
 
     if ((header_file != NULL) && (stringlist_get_size(data_files) > 0)) {
-      summary = ecl_sum_fread_alloc(header_file , data_files , SUMMARY_KEY_JOIN_STRING );
+      summary = ecl_sum_fread_alloc_lazy(header_file , data_files , SUMMARY_KEY_JOIN_STRING );
       {
         time_t end_time = ecl_config_get_end_date( load_context->ecl_config );
         if (end_time > 0) {
@@ -146,6 +147,7 @@ forward_load_context_type * forward_load_context_alloc( const run_arg_type * run
   load_context->messages = messages;
   load_context->ecl_config = ecl_config;
   load_context->eclbase = util_alloc_string_copy( eclbase );
+  load_context->restart_keywords = NULL;
 
   if (load_summary)
     forward_load_context_load_ecl_sum(load_context);
@@ -189,6 +191,9 @@ void forward_load_context_free( forward_load_context_type * load_context ) {
   if (load_context->ecl_sum)
     ecl_sum_free( load_context->ecl_sum );
 
+  if (load_context->restart_keywords)
+    stringlist_free( load_context->restart_keywords );
+
   util_safe_free( load_context->eclbase );
   free( load_context );
 }
@@ -213,7 +218,10 @@ bool forward_load_context_load_restart_file( forward_load_context_type * load_co
       load_context->restart_file = NULL;
 
       if (filename) {
-        load_context->restart_file = ecl_file_open( filename , 0 );
+        if (load_context->restart_keywords)
+          load_context->restart_file = ecl_file_open_restart_subset( filename , load_context->restart_keywords , NULL , 0 );
+        else
+          load_context->restart_file = ecl_file_open( filename , 0 );
         free(filename);
       }
 
@@ -231,6 +239,24 @@ bool forward_load_context_load_restart_file( forward_load_context_type * load_co
 
 
 
+/*
+  Will limit the keywords indexed when the restart file is opened with
+  forward_load_context_load_restart_file() to the keywords in
+  @restart_keywords; the other keywords in the restart file will not
+  be available. Pass NULL to go back to indexing all keywords.
+*/
+
+void forward_load_context_select_restart_keywords( forward_load_context_type * load_context , const stringlist_type * restart_keywords) {
+  if (load_context->restart_keywords)
+    stringlist_free( load_context->restart_keywords );
+
+  if (restart_keywords)
+    load_context->restart_keywords = stringlist_alloc_deep_copy( restart_keywords );
+  else
+    load_context->restart_keywords = NULL;
+}
+
+
 const ecl_sum_type * forward_load_context_get_ecl_sum( const forward_load_context_type * load_context) {
   return load_context->ecl_sum;
 }
@@ -49,6 +49,8 @@ void fs_driver_init(fs_driver_type * driver) {
   
   driver->free_driver   = NULL;
   driver->fsync_driver  = NULL;
+  driver->begin_batch   = NULL;
+  driver->commit_batch  = NULL;
 }
 
 void fs_driver_assert_cast(const fs_driver_type * driver) {
@@ -232,6 +232,8 @@ void * plain_driver_alloc(const char * mount_point , const char * node_fmt, cons
   driver->has_vector          = plain_driver_has_vector;
 
   driver->fsync_driver        = NULL;
+  driver->begin_batch         = NULL;
+  driver->commit_batch        = NULL;
   driver->free_driver         = plain_driver_free;
   driver->mount_point         = util_alloc_string_copy( mount_point );
   driver->node_fmt            = util_alloc_sprintf( "%s%c%s" , mount_point , UTIL_PATH_SEP_CHAR , node_fmt );
@@ -25,6 +25,7 @@
 #include <ert/util/util.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/vector.h>
+#include <ert/util/thread_pool.h>
 
 #include <ert/job_queue/job_queue.h>
 #include <ert/job_queue/ext_job.h>
@@ -138,6 +139,20 @@ mode_t site_config_get_umask(const site_config_type * site_config) {
   return site_config->umask;
 }
 
+/*
+  The number of threads is a process wide setting held by the
+  thread_pool implementation; the ERT_MAX_THREADS environment variable
+  will override the value set here.
+*/
+
+void site_config_set_max_threads(site_config_type * site_config, int max_threads) {
+  thread_pool_set_cpu_budget(max_threads);
+}
+
+int site_config_get_max_threads(const site_config_type * site_config) {
+  return thread_pool_get_cpu_budget();
+}
+
 static void site_config_add_queue_driver(site_config_type * site_config, const char * driver_name, queue_driver_type * driver) {
   hash_insert_hash_owned_ref(site_config->queue_drivers, driver_name, driver, queue_driver_free__);
 }
@@ -719,6 +734,9 @@ bool site_config_init(site_config_type * site_config, const config_content_type
   if (config_content_has_item(config, MAX_SUBMIT_KEY))
     site_config_set_max_submit(site_config, config_content_get_value_as_int(config, MAX_SUBMIT_KEY));
 
+  if (config_content_has_item(config, MAX_THREADS_KEY))
+    site_config_set_max_threads(site_config, config_content_get_value_as_int(config, MAX_THREADS_KEY));
+
 
   /* LSF options */
   {
@@ -892,6 +910,10 @@ void site_config_add_config_items(config_parser_type * config, bool site_mode) {
   item = config_add_schema_item(config, UMASK_KEY, false);
   config_schema_item_set_argc_minmax(item, 1, 1);
 
+  item = config_add_schema_item(config, MAX_THREADS_KEY, false);
+  config_schema_item_set_argc_minmax(item, 1, 1);
+  config_schema_item_iset_type(item, 0, CONFIG_INT);
+
   /**
      UPDATE_PATH   LD_LIBRARY_PATH   /path/to/some/funky/lib
 
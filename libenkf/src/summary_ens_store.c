@@ -0,0 +1,313 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'summary_ens_store.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#define  _GNU_SOURCE   /* Must define this to get access to pthread_rwlock_t */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+#include <ert/util/buffer.h>
+#include <ert/util/type_macros.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/matrix.h>
+
+#include <ert/enkf/summary_ens_store.h>
+
+/*
+  The summary_ens_store keeps the summary results of the whole
+  ensemble as one file per summary key, organised as a [realization x
+  report_step] table. Each realization owns one fixed size row, which
+  is written in place when the realization is loaded; reading one key
+  for the whole ensemble is then one contiguous read of one file,
+  instead of one lookup per realization in the block_fs storage.
+
+  File layout:
+
+    int   magic
+    int   row_capacity
+    row 0
+    row 1
+    ....
+
+  where every row is:
+
+    int    length           Number of valid report steps; 0 means no data.
+    int    reserved
+    double value[row_capacity]
+
+  Rows for realizations which have not been loaded are holes in the
+  file, and are read back with length == 0. When a realization brings
+  a longer vector than the current row_capacity the whole file is
+  rewritten with a larger capacity; that is the only operation which
+  takes the write lock, ordinary row writes only take the read lock
+  and can proceed concurrently.
+*/
+
+#define SUMMARY_ENS_STORE_TYPE_ID  661076231
+#define SUMMARY_ENS_STORE_MAGIC    716402134
+#define SUMMARY_ENS_STORE_BLOCK    64            /* The row capacity is allocated in blocks of this many report steps. */
+
+#define HEADER_SIZE     (2 * sizeof(int))
+#define ROW_HEADER_SIZE (2 * sizeof(int))
+
+
+struct summary_ens_store_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  char             * path;
+  bool               read_only;
+  pthread_rwlock_t   rw_lock;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( summary_ens_store , SUMMARY_ENS_STORE_TYPE_ID )
+
+
+summary_ens_store_type * summary_ens_store_alloc( const char * path , bool read_only ) {
+  summary_ens_store_type * store = util_malloc( sizeof * store );
+  UTIL_TYPE_ID_INIT( store , SUMMARY_ENS_STORE_TYPE_ID );
+  store->path = util_alloc_string_copy( path );
+  store->read_only = read_only;
+  pthread_rwlock_init( &store->rw_lock , NULL );
+  return store;
+}
+
+
+void summary_ens_store_free( summary_ens_store_type * store ) {
+  pthread_rwlock_destroy( &store->rw_lock );
+  free( store->path );
+  free( store );
+}
+
+
+const char * summary_ens_store_get_path( const summary_ens_store_type * store ) {
+  return store->path;
+}
+
+
+bool summary_ens_store_is_read_only( const summary_ens_store_type * store ) {
+  return store->read_only;
+}
+
+
+/*
+  Summary keys can contain any character; '/' and '%' are escaped as
+  %XX to get a valid filename.
+*/
+
+static char * summary_ens_store_alloc_filename( const summary_ens_store_type * store , const char * key ) {
+  char * escaped_key = util_calloc( 3 * strlen( key ) + 1 , sizeof * escaped_key );
+  char * filename;
+  {
+    int offset = 0;
+    for (int i = 0; i < strlen( key ); i++) {
+      if ((key[i] == '/') || (key[i] == '%'))
+        offset += sprintf( &escaped_key[offset] , "%%%02X" , key[i] );
+      else {
+        escaped_key[offset] = key[i];
+        offset++;
+      }
+    }
+    escaped_key[offset] = '\0';
+  }
+  filename = util_alloc_filename( store->path , escaped_key , NULL );
+  free( escaped_key );
+  return filename;
+}
+
+
+static size_t summary_ens_store_row_size( int row_capacity ) {
+  return ROW_HEADER_SIZE + row_capacity * sizeof(double);
+}
+
+
+static offset_type summary_ens_store_row_offset( int row_capacity , int iens ) {
+  return (offset_type) HEADER_SIZE + (offset_type) iens * summary_ens_store_row_size( row_capacity );
+}
+
+
+/*
+  Returns the row capacity of the file, or -1 if the file does not
+  exist.
+*/
+
+static int summary_ens_store_fread_capacity( const char * filename ) {
+  int row_capacity = -1;
+  FILE * stream = fopen( filename , "r");
+  if (stream != NULL) {
+    int magic = util_fread_int( stream );
+    if (magic != SUMMARY_ENS_STORE_MAGIC)
+      util_abort("%s: the file:%s is not a summary ensemble file.\n",__func__ , filename);
+
+    row_capacity = util_fread_int( stream );
+    fclose( stream );
+  }
+  return row_capacity;
+}
+
+
+/*
+  Must be called with the write lock held. Will create the file, or
+  rewrite it with a larger row capacity, so that rows of length
+  min_capacity can be stored.
+*/
+
+static void summary_ens_store_grow( summary_ens_store_type * store , const char * filename , int min_capacity ) {
+  int old_capacity = summary_ens_store_fread_capacity( filename );
+  if (old_capacity >= min_capacity)
+    return;   /* Another thread got here first. */
+
+  {
+    int new_capacity = util_int_max( min_capacity , 2 * old_capacity );
+    new_capacity = SUMMARY_ENS_STORE_BLOCK * ((new_capacity + SUMMARY_ENS_STORE_BLOCK - 1) / SUMMARY_ENS_STORE_BLOCK);
+
+    if (old_capacity < 0) {
+      FILE * stream;
+      util_make_path( store->path );
+      stream = util_fopen( filename , "w");
+      util_fwrite_int( SUMMARY_ENS_STORE_MAGIC , stream );
+      util_fwrite_int( new_capacity , stream );
+      fclose( stream );
+    } else {
+      char * tmp_file = util_alloc_sprintf( "%s.tmp" , filename );
+      size_t old_row_size = summary_ens_store_row_size( old_capacity );
+      size_t new_row_size = summary_ens_store_row_size( new_capacity );
+      FILE * src_stream = util_fopen( filename , "r");
+      FILE * target_stream = util_fopen( tmp_file , "w");
+      char * row_buffer = util_calloc( new_row_size , sizeof * row_buffer );
+      offset_type num_rows = (util_file_size( filename ) - HEADER_SIZE) / old_row_size;
+
+      util_fseek( src_stream , HEADER_SIZE , SEEK_SET );
+      util_fwrite_int( SUMMARY_ENS_STORE_MAGIC , target_stream );
+      util_fwrite_int( new_capacity , target_stream );
+
+      memset( row_buffer , 0 , new_row_size );
+      for (offset_type row = 0; row < num_rows; row++) {
+        util_fread( row_buffer , 1 , old_row_size , src_stream , __func__ );
+        util_fwrite( row_buffer , 1 , new_row_size , target_stream , __func__ );
+      }
+
+      fclose( src_stream );
+      fclose( target_stream );
+      if (rename( tmp_file , filename ) != 0)
+        util_abort("%s: failed to rename %s -> %s: %s \n",__func__ , tmp_file , filename , strerror( errno ));
+
+      free( row_buffer );
+      free( tmp_file );
+    }
+  }
+}
+
+
+void summary_ens_store_fwrite_row( summary_ens_store_type * store , const char * key , int iens , const double_vector_type * data ) {
+  if (store->read_only)
+    util_abort("%s: tried to write to read only summary store:%s \n",__func__ , store->path);
+  {
+    char * filename = summary_ens_store_alloc_filename( store , key );
+    int length = double_vector_size( data );
+    int row_capacity;
+
+    pthread_rwlock_rdlock( &store->rw_lock );
+    row_capacity = summary_ens_store_fread_capacity( filename );
+    while (row_capacity < util_int_max( length , 1 )) {
+      pthread_rwlock_unlock( &store->rw_lock );
+      pthread_rwlock_wrlock( &store->rw_lock );
+      summary_ens_store_grow( store , filename , util_int_max( length , 1 ));
+      pthread_rwlock_unlock( &store->rw_lock );
+
+      pthread_rwlock_rdlock( &store->rw_lock );
+      row_capacity = summary_ens_store_fread_capacity( filename );
+    }
+
+    {
+      size_t row_size = summary_ens_store_row_size( row_capacity );
+      char * row = util_calloc( row_size , sizeof * row );
+      int row_header[2] = { length , 0 };
+      FILE * stream = util_fopen( filename , "r+");
+
+      memset( row , 0 , row_size );
+      memcpy( row , row_header , ROW_HEADER_SIZE );
+      memcpy( &row[ROW_HEADER_SIZE] , double_vector_get_const_ptr( data ) , length * sizeof(double) );
+
+      util_fseek( stream , summary_ens_store_row_offset( row_capacity , iens ) , SEEK_SET );
+      util_fwrite( row , 1 , row_size , stream , __func__ );
+      fclose( stream );
+      free( row );
+    }
+    pthread_rwlock_unlock( &store->rw_lock );
+    free( filename );
+  }
+}
+
+
+bool summary_ens_store_has_key( const summary_ens_store_type * store , const char * key ) {
+  char * filename = summary_ens_store_alloc_filename( store , key );
+  bool has_key = util_file_exists( filename );
+  free( filename );
+  return has_key;
+}
+
+
+/*
+  Will read the data for all realizations for the key in one read;
+  data is resized to [num_rows x row_capacity] and length holds the
+  number of valid report steps for each realization, 0 for the
+  realizations without data. Returns false if there is no data for
+  this key.
+*/
+
+bool summary_ens_store_fread_key( summary_ens_store_type * store , const char * key , matrix_type * data , int_vector_type * length ) {
+  bool has_data = false;
+  char * filename = summary_ens_store_alloc_filename( store , key );
+
+  int_vector_reset( length );
+  pthread_rwlock_rdlock( &store->rw_lock );
+  if (util_file_exists( filename )) {
+    buffer_type * buffer = buffer_fread_alloc( filename );
+    buffer_fskip_int( buffer );    /* The magic has been checked by the writer. */
+    {
+      int row_capacity = buffer_fread_int( buffer );
+      int num_rows = (buffer_get_size( buffer ) - HEADER_SIZE) / summary_ens_store_row_size( row_capacity );
+
+      if (num_rows > 0) {
+        matrix_resize( data , num_rows , row_capacity , false );
+        for (int iens = 0; iens < num_rows; iens++) {
+          int row_length;
+          buffer_fseek( buffer , summary_ens_store_row_offset( row_capacity , iens ) , SEEK_SET );
+          row_length = buffer_fread_int( buffer );
+          buffer_fskip_int( buffer );
+
+          for (int step = 0; step < row_length; step++)
+            matrix_iset( data , iens , step , buffer_fread_double( buffer ));
+
+          int_vector_iset( length , iens , row_length );
+        }
+        has_data = true;
+      }
+    }
+    buffer_free( buffer );
+  }
+  pthread_rwlock_unlock( &store->rw_lock );
+
+  free( filename );
+  return has_data;
+}
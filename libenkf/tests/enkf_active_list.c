@@ -58,6 +58,25 @@ int main(int argc , char ** argv) {
   active_list_copy( active_list1 , active_list2 );
   test_assert_true(active_list_equal( active_list1 , active_list2 ));
 
+  {
+    active_list_type * all_active = active_list_alloc( );
+    active_list_type * slice1 = active_list_alloc_slice( all_active , 5 , 3 );
+    active_list_type * slice2 = active_list_alloc_slice( active_list2 , 1 , 2 );
+
+    test_assert_int_equal( PARTLY_ACTIVE , active_list_get_mode( slice1 ));
+    test_assert_int_equal( 3 , active_list_get_active_size( slice1 , 100 ));
+    test_assert_int_equal( 5 , active_list_get_active( slice1 )[0] );
+    test_assert_int_equal( 7 , active_list_get_active( slice1 )[2] );
+
+    test_assert_int_equal( 2 , active_list_get_active_size( slice2 , 100 ));
+    test_assert_int_equal( 12 , active_list_get_active( slice2 )[0] );
+    test_assert_int_equal( 13 , active_list_get_active( slice2 )[1] );
+
+    active_list_free( slice2 );
+    active_list_free( slice1 );
+    active_list_free( all_active );
+  }
+
   active_list_free( active_list1 );
   active_list_free( active_list2 );
   exit(0);
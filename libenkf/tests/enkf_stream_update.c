@@ -0,0 +1,80 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_stream_update.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/gen_kw.h>
+#include <ert/enkf/gen_kw_config.h>
+#include <ert/enkf/ert_test_context.h>
+
+
+void smoother_update( enkf_main_type * enkf_main , const char * target_case , int chunk_size ) {
+  analysis_config_type * analysis_config = enkf_main_get_analysis_config( enkf_main );
+  enkf_fs_type * source_fs = enkf_main_get_fs( enkf_main );
+  enkf_fs_type * target_fs = enkf_main_mount_alt_fs( enkf_main , target_case , true );
+
+  analysis_config_set_stream_chunk_size( analysis_config , chunk_size );
+  enkf_main_rng_init( enkf_main );
+  test_assert_true( enkf_main_smoother_update( enkf_main , source_fs , target_fs ));
+
+  enkf_fs_decref( target_fs );
+}
+
+
+void test_equal_update( enkf_main_type * enkf_main , const char * key ) {
+  const enkf_config_node_type * config_node = ensemble_config_get_node( enkf_main_get_ensemble_config( enkf_main ) , key );
+  const gen_kw_config_type * gen_kw_config = enkf_config_node_get_ref( config_node );
+  enkf_fs_type * full_fs = enkf_main_mount_alt_fs( enkf_main , "full_update" , false );
+  enkf_fs_type * stream_fs = enkf_main_mount_alt_fs( enkf_main , "stream_update" , false );
+  enkf_node_type * full_node = enkf_node_alloc( config_node );
+  enkf_node_type * stream_node = enkf_node_alloc( config_node );
+
+  for (int iens = 0; iens < enkf_main_get_ensemble_size( enkf_main ); iens++) {
+    node_id_type node_id = {.report_step = 0 , .iens = iens };
+    enkf_node_load( full_node , full_fs , node_id );
+    enkf_node_load( stream_node , stream_fs , node_id );
+
+    for (int i = 0; i < gen_kw_config_get_data_size( gen_kw_config ); i++)
+      test_assert_double_equal( gen_kw_data_iget( enkf_node_value_ptr( full_node ) , i , false ) ,
+                                gen_kw_data_iget( enkf_node_value_ptr( stream_node ) , i , false ));
+  }
+
+  enkf_node_free( full_node );
+  enkf_node_free( stream_node );
+  enkf_fs_decref( full_fs );
+  enkf_fs_decref( stream_fs );
+}
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  ert_test_context_type * test_context = ert_test_context_alloc("StreamUpdate" , config_file);
+  enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+
+  /* A chunk size of 3 splits the ten SNAKE_OIL_PARAM parameters over four chunks. */
+  smoother_update( enkf_main , "full_update" , 0 );
+  smoother_update( enkf_main , "stream_update" , 3 );
+  test_equal_update( enkf_main , "SNAKE_OIL_PARAM" );
+
+  ert_test_context_free( test_context );
+  exit(0);
+}
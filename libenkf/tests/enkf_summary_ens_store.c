@@ -0,0 +1,109 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_summary_ens_store.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/matrix.h>
+
+#include <ert/enkf/summary_ens_store.h>
+
+
+void write_row( summary_ens_store_type * store , const char * key , int iens , int length ) {
+  double_vector_type * data = double_vector_alloc( 0 , 0 );
+  for (int step = 0; step < length; step++)
+    double_vector_iset( data , step , iens * 1000 + step );
+
+  summary_ens_store_fwrite_row( store , key , iens , data );
+  double_vector_free( data );
+}
+
+
+void test_rows( summary_ens_store_type * store , const char * key , const int * lengths , int num_rows ) {
+  matrix_type * data = matrix_alloc( 1 , 1 );
+  int_vector_type * length = int_vector_alloc( 0 , 0 );
+
+  test_assert_true( summary_ens_store_fread_key( store , key , data , length ));
+  test_assert_int_equal( num_rows , int_vector_size( length ));
+  test_assert_int_equal( num_rows , matrix_get_rows( data ));
+  for (int iens = 0; iens < num_rows; iens++) {
+    test_assert_int_equal( lengths[iens] , int_vector_iget( length , iens ));
+    for (int step = 0; step < lengths[iens]; step++)
+      test_assert_double_equal( iens * 1000 + step , matrix_iget( data , iens , step ));
+  }
+
+  int_vector_free( length );
+  matrix_free( data );
+}
+
+
+void test_write_read() {
+  test_work_area_type * work_area = test_work_area_alloc( "summary_ens_store" );
+  {
+    summary_ens_store_type * store = summary_ens_store_alloc( "store" , false );
+    test_assert_true( summary_ens_store_is_instance( store ));
+    test_assert_false( summary_ens_store_has_key( store , "FOPT" ));
+    {
+      matrix_type * data = matrix_alloc( 1 , 1 );
+      int_vector_type * length = int_vector_alloc( 0 , 0 );
+      test_assert_false( summary_ens_store_fread_key( store , "FOPT" , data , length ));
+      int_vector_free( length );
+      matrix_free( data );
+    }
+
+    write_row( store , "FOPT" , 0 , 10 );
+    write_row( store , "FOPT" , 2 , 10 );
+    test_assert_true( summary_ens_store_has_key( store , "FOPT" ));
+    {
+      int lengths[3] = { 10 , 0 , 10 };
+      test_rows( store , "FOPT" , lengths , 3 );
+    }
+
+    /* Longer than the initial row capacity; the existing rows must survive the resize. */
+    write_row( store , "FOPT" , 1 , 200 );
+    write_row( store , "FOPT" , 0 , 5 );
+    {
+      int lengths[3] = { 5 , 200 , 10 };
+      test_rows( store , "FOPT" , lengths , 3 );
+    }
+
+    write_row( store , "WOPR:OP/1" , 1 , 3 );
+    summary_ens_store_free( store );
+  }
+  {
+    summary_ens_store_type * store = summary_ens_store_alloc( "store" , true );
+    int lengths[3] = { 5 , 200 , 10 };
+    test_rows( store , "FOPT" , lengths , 3 );
+    {
+      int lengths[2] = { 0 , 3 };
+      test_rows( store , "WOPR:OP/1" , lengths , 2 );
+    }
+    test_assert_false( summary_ens_store_has_key( store , "WOPR:OP" ));
+    summary_ens_store_free( store );
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main(int argc , char ** argv) {
+  test_write_read();
+  exit(0);
+}
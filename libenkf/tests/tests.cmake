@@ -180,6 +180,13 @@ add_test( enkf_select_case_job
           ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert
           ${PROJECT_SOURCE_DIR}/share/workflows/jobs/internal-tui/config/SELECT_CASE)
 
+add_executable( enkf_stream_update enkf_stream_update.c )
+target_link_libraries( enkf_stream_update  enkf  )
+
+add_test( enkf_stream_update
+          ${EXECUTABLE_OUTPUT_PATH}/enkf_stream_update
+          ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert )
+
 
 #-----------------------------------------------------------------
 
@@ -240,6 +247,10 @@ add_executable( enkf_state_map enkf_state_map.c )
 target_link_libraries( enkf_state_map enkf  )
 add_test( enkf_state_map  ${EXECUTABLE_OUTPUT_PATH}/enkf_state_map )
 
+add_executable( enkf_summary_ens_store enkf_summary_ens_store.c )
+target_link_libraries( enkf_summary_ens_store enkf  )
+add_test( enkf_summary_ens_store  ${EXECUTABLE_OUTPUT_PATH}/enkf_summary_ens_store )
+
 
 add_executable( enkf_meas_data enkf_meas_data.c )
 target_link_libraries( enkf_meas_data enkf  )
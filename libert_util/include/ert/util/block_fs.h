@@ -52,6 +52,8 @@ extern "C" {
   void            block_fs_close( block_fs_type * block_fs , bool unlink_empty);
   void            block_fs_fwrite_file(block_fs_type * block_fs , const char * filename , const void * ptr , size_t byte_size);
   void            block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , const buffer_type * buffer);
+  void            block_fs_begin_batch( block_fs_type * block_fs );
+  void            block_fs_commit_batch( block_fs_type * block_fs );
   void            block_fs_fread_file( block_fs_type * block_fs , const char * filename , void * ptr);
   int             block_fs_get_filesize( block_fs_type * block_fs , const char * filename);
   void            block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * filename , buffer_type * buffer);
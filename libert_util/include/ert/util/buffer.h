@@ -31,6 +31,7 @@ extern "C" {
 #include <ert/util/ert_api_config.h>
 #include <ert/util/type_macros.h>
 #include <ert/util/ssize_t.h>
+#include <ert/util/util.h>
 
 
 
@@ -94,6 +95,10 @@ extern "C" {
   buffer_type      * buffer_fread_alloc(const char * filename);
   void               buffer_fread_realloc(buffer_type * buffer , const char * filename);
 
+#ifdef ERT_HAVE_PREAD
+  void               buffer_fd_pread( buffer_type * buffer , size_t byte_size , int fd , offset_type offset);
+#endif
+
 #ifdef ERT_HAVE_ZLIB
   size_t             buffer_fwrite_compressed(buffer_type * buffer, const void * ptr , size_t byte_size);
   size_t             buffer_fread_compressed(buffer_type * buffer , size_t compressed_size , void * target_ptr , size_t target_size);
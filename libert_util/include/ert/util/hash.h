@@ -42,6 +42,8 @@ hash_type       * hash_alloc_unlocked(void);
 void              hash_iter_complete(hash_type * );
 void              hash_free(hash_type *);
 void              hash_free__(void *);
+void              hash_freeze(hash_type * hash);
+bool              hash_is_frozen(const hash_type * hash);
 void              hash_insert_ref(hash_type * , const char * , const void *);
 void              hash_insert_copy(hash_type *, const char * , const void *, copyc_ftype *, free_ftype *);
 void              hash_insert_string(hash_type *, const char *, const char *);
@@ -25,16 +25,23 @@ extern "C" {
 #include <stdbool.h>
 
   typedef struct     thread_pool_struct thread_pool_type;
+  typedef void      (thread_pool_range_ftype) (int begin , int end , void * arg);
 
   void               thread_pool_join(thread_pool_type * );
   thread_pool_type * thread_pool_alloc(int , bool start_queue);
-  void               thread_pool_add_job(thread_pool_type * ,void * (*) (void *) , void *);
+  int                thread_pool_add_job(thread_pool_type * ,void * (*) (void *) , void *);
+  void             * thread_pool_wait_job( thread_pool_type * pool , int queue_index );
+  void               thread_pool_parallel_for( thread_pool_type * pool , int begin , int end , int grain_size , thread_pool_range_ftype * body , void * arg );
   void               thread_pool_free(thread_pool_type *);
   void               thread_pool_restart( thread_pool_type * tp );
   void             * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_index );
   int                thread_pool_get_max_running( const thread_pool_type * pool );
   bool               thread_pool_try_join(thread_pool_type * pool, int timeout_seconds);
 
+  int                thread_pool_get_cpu_budget( void );
+  void               thread_pool_set_cpu_budget( int num_cpu );
+  int                thread_pool_get_default_size( int num_jobs );
+
 #ifdef __cplusplus
 }
 #endif
@@ -318,6 +318,7 @@ typedef enum {left_pad   = 0,
   char *  util_fread_alloc_string(FILE *);
   void    util_fskip_string(FILE *stream);
   void     util_endian_flip_vector(void * data , int element_size , int elements);
+  void     util_endian_flip_copy(void * target , const void * src , int element_size , int elements);
   int      util_proc_mem_free(void);
 
 
@@ -526,6 +527,12 @@ void    util_abort_set_executable( const char * argv0 );
 #endif
 
 
+#ifdef ERT_HAVE_PREAD
+  void         util_pread(int fd , void * ptr , size_t byte_size , offset_type offset , const char * caller);
+  void         util_pwrite(int fd , const void * ptr , size_t byte_size , offset_type offset , const char * caller);
+#endif
+
+
 #ifdef ERT_HAVE_LOCKF
   FILE       * util_fopen_lockf(const char * , const char * );
   bool         util_try_lockf(const char *  , mode_t  , int * );
@@ -27,6 +27,7 @@
 #include <time.h>
 #include <fnmatch.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
 #include <ert/util/block_fs.h>
@@ -116,6 +117,19 @@ struct file_node_struct{
 };
 
 
+/*
+  A write which has been made while a batch is open, and which will
+  be written to the data file when the batch is committed.
+*/
+
+typedef struct {
+  char   * filename;
+  void   * data;
+  size_t   data_size;
+  bool     unlinked;         /* The file has been unlinked after it was written in the batch. */
+} batch_node_type;
+
+
 /**
    data_size   : manipulated in block_fs_fwrite__() and block_fs_insert_free_node().
    status      : manipulated in block_fs_fwrite__() and block_fs_unlink_file__();
@@ -147,7 +161,7 @@ struct block_fs_struct {
   int              block_size;      /* The size of blocks in bytes. */
   int              lock_fd;         /* The file descriptor for the lock_file. Set to -1 if we do not have write access. */
   
-  pthread_mutex_t  io_lock;         /* Lock held during fread of the data file. */
+  pthread_mutex_t  io_lock;         /* Lock held during fread of the data file; not used when the data is read with pread(). */
   pthread_rwlock_t rw_lock;         /* Read-write lock during all access to the fs. */
   
   int              num_free_nodes;   
@@ -164,6 +178,11 @@ struct block_fs_struct {
                                             fragmentation_limit == 0.0 : Rotate when one byte is wasted. */
   bool             data_owner;
   int              fsync_interval;  /* 0: never  n: every nth iteration. */
+
+  pthread_mutex_t  batch_lock;      /* Protects the batch_xxx fields. */
+  int              batch_depth;     /* The number of block_fs_begin_batch() calls without a matching block_fs_commit_batch(). */
+  hash_type      * batch_index;     /* filename -> batch_node_type for the writes pending in the current batch. */
+  vector_type    * batch_nodes;     /* Owns the batch_node_type instances, in the order the writes were made. */
 };
 
 /*****************************************************************/
@@ -456,6 +475,48 @@ static file_node_type * file_node_index_buffer_fread_alloc( buffer_type * buffer
 /* file_node functions - end. */
 /*****************************************************************/
 
+static batch_node_type * batch_node_alloc( const char * filename , const void * data , size_t data_size) {
+  batch_node_type * batch_node = util_malloc( sizeof * batch_node );
+  batch_node->filename  = util_alloc_string_copy( filename );
+  batch_node->data      = util_alloc_copy( data , data_size );
+  batch_node->data_size = data_size;
+  batch_node->unlinked  = false;
+  return batch_node;
+}
+
+
+static void batch_node_free( batch_node_type * batch_node ) {
+  free( batch_node->filename );
+  util_safe_free( batch_node->data );
+  free( batch_node );
+}
+
+
+static void batch_node_free__( void * arg ) {
+  batch_node_free( (batch_node_type *) arg );
+}
+
+
+/**
+   Writes the complete on-disk image of the node, i.e. the header,
+   the data, padding and the NODE_END_TAG, to the current end of the
+   buffer. The layout must be identical to what is written by
+   file_node_fwrite() and block_fs_fwrite__().
+*/
+
+static void file_node_buffer_fwrite_image( const file_node_type * file_node , const char * key , const void * data , buffer_type * image) {
+  size_t node_start = buffer_get_size( image );
+  buffer_fwrite_int( image , file_node->status );
+  buffer_fwrite_string( image , key );
+  buffer_fwrite_int( image , file_node->node_size );
+  buffer_fwrite_int( image , file_node->data_size );
+  buffer_fwrite( image , data , 1 , file_node->data_size );
+  while (buffer_get_size( image ) < (node_start + file_node->node_size - sizeof NODE_END_TAG))
+    buffer_fwrite_char( image , 0 );
+  buffer_fwrite_int( image , NODE_END_TAG );
+}
+
+
 static free_node_type * free_node_alloc( file_node_type * file_node ) {
   free_node_type * free_node = util_malloc( sizeof * free_node );
 
@@ -663,6 +724,10 @@ static block_fs_type * block_fs_alloc_empty( const char * mount_file ,
   util_alloc_file_components( mount_file , &block_fs->path , &block_fs->base_name, NULL );
   pthread_mutex_init( &block_fs->io_lock  , NULL);
   pthread_rwlock_init( &block_fs->rw_lock , NULL);
+  pthread_mutex_init( &block_fs->batch_lock , NULL);
+  block_fs->batch_depth = 0;
+  block_fs->batch_index = hash_alloc();
+  block_fs->batch_nodes = vector_alloc_new();
   {
     FILE * stream            = util_fopen( mount_file , "r");
     int id                   = util_fread_int( stream );
@@ -717,9 +782,11 @@ static void block_fs_fseek_node_end(block_fs_type * block_fs , const file_node_t
   block_fs_fseek( block_fs , file_node->node_offset + file_node->node_size);
 }
 
+#ifndef ERT_HAVE_PREAD
 static void block_fs_fseek_node_data(block_fs_type * block_fs , const file_node_type * file_node) {
   block_fs_fseek( block_fs , file_node->node_offset + file_node->data_offset );
 }
+#endif
 
 
 
@@ -1170,6 +1237,90 @@ static file_node_type * block_fs_get_new_node( block_fs_type * block_fs , const
 
 
 
+/*****************************************************************/
+/*
+  Batched writes. While a batch is open the writes are kept in memory
+  in the batch_nodes vector, and the read functions look in the batch
+  before they look in the data file. All the pending writes are
+  written to the data file when the batch is committed; see
+  block_fs_commit_batch().
+*/
+
+static bool block_fs_batch_fwrite( block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
+  bool batched = false;
+  pthread_mutex_lock( &block_fs->batch_lock );
+  if (block_fs->batch_depth > 0) {
+    batch_node_type * batch_node = batch_node_alloc( filename , ptr , data_size );
+
+    /* A file written twice in the same batch is only written to disk once. */
+    if (hash_has_key( block_fs->batch_index , filename )) {
+      batch_node_type * old_node = hash_get( block_fs->batch_index , filename );
+      old_node->unlinked = true;
+    }
+    vector_append_owned_ref( block_fs->batch_nodes , batch_node , batch_node_free__ );
+    hash_insert_ref( block_fs->batch_index , filename , batch_node );
+    batched = true;
+  }
+  pthread_mutex_unlock( &block_fs->batch_lock );
+  return batched;
+}
+
+
+/*
+  Returns true if the unlink is complete, i.e. the file was only
+  present in the batch.
+*/
+
+static bool block_fs_batch_unlink( block_fs_type * block_fs , const char * filename ) {
+  bool in_batch = false;
+  pthread_mutex_lock( &block_fs->batch_lock );
+  if (hash_has_key( block_fs->batch_index , filename )) {
+    batch_node_type * batch_node = hash_get( block_fs->batch_index , filename );
+    batch_node->unlinked = true;
+    hash_del( block_fs->batch_index , filename );
+    in_batch = true;
+  }
+  pthread_mutex_unlock( &block_fs->batch_lock );
+
+  /* The batch_lock must not be held while waiting for the rwlock; block_fs_commit_batch__() takes them in the opposite order. */
+  if (in_batch) {
+    bool on_disk;
+    block_fs_aquire_rlock( block_fs );
+    on_disk = hash_has_key( block_fs->index , filename );
+    block_fs_release_rwlock( block_fs );
+    return !on_disk;
+  } else
+    return false;
+}
+
+
+/*
+  Looks for @filename among the pending writes of the current batch;
+  if it is found the data is copied to @buffer or @ptr (if not NULL)
+  and the size of the file is returned, otherwise -1 is returned.
+*/
+
+static int block_fs_batch_fread( block_fs_type * block_fs , const char * filename , buffer_type * buffer , void * ptr) {
+  int data_size = -1;
+  pthread_mutex_lock( &block_fs->batch_lock );
+  if (hash_has_key( block_fs->batch_index , filename )) {
+    const batch_node_type * batch_node = hash_get( block_fs->batch_index , filename );
+    data_size = batch_node->data_size;
+
+    if (buffer != NULL) {
+      buffer_clear( buffer );
+      buffer_fwrite( buffer , batch_node->data , 1 , batch_node->data_size );
+      buffer_rewind( buffer );
+    }
+
+    if (ptr != NULL)
+      memcpy( ptr , batch_node->data , batch_node->data_size );
+  }
+  pthread_mutex_unlock( &block_fs->batch_lock );
+  return data_size;
+}
+
+
 bool block_fs_has_file__( const block_fs_type * block_fs , const char * filename) {
   return hash_has_key( block_fs->index , filename );
 }
@@ -1178,6 +1329,9 @@ bool block_fs_has_file__( const block_fs_type * block_fs , const char * filename
 
 bool block_fs_has_file( block_fs_type * block_fs , const char * filename) {
   bool has_file;
+  if (block_fs_batch_fread( block_fs , filename , NULL , NULL ) >= 0)
+    return true;
+
   block_fs_aquire_rlock( block_fs );
   {
     has_file = block_fs_has_file__( block_fs , filename );
@@ -1189,7 +1343,12 @@ bool block_fs_has_file( block_fs_type * block_fs , const char * filename) {
 
 
 
-static void block_fs_unlink_file__( block_fs_type * block_fs , const char * filename ) {
+/*
+  When committing a batch the fsync() calls are skipped, the batch is
+  synced once when all the nodes have been written.
+*/
+
+static void block_fs_unlink_file__( block_fs_type * block_fs , const char * filename , bool fsync_data) {
   file_node_type * node = hash_pop( block_fs->index , filename );
   block_fs_clear_cache_node( block_fs , node );
 
@@ -1197,10 +1356,12 @@ static void block_fs_unlink_file__( block_fs_type * block_fs , const char * file
   node->data_offset = 0;
   node->data_size   = 0;
   if (block_fs->data_stream != NULL) {  
-    fsync( block_fs->data_fd );
+    if (fsync_data)
+      fsync( block_fs->data_fd );
     block_fs_fseek(block_fs , node->node_offset);
     file_node_fwrite( node , NULL , block_fs->data_stream );
-    fsync( block_fs->data_fd );
+    if (fsync_data)
+      fsync( block_fs->data_fd );
   }
   block_fs_insert_free_node( block_fs , node );
 }
@@ -1214,9 +1375,12 @@ double block_fs_get_fragmentation( const block_fs_type * block_fs ) {
 
 
 void block_fs_unlink_file( block_fs_type * block_fs , const char * filename) {
+  if (block_fs_batch_unlink( block_fs , filename ))
+    return;
+
   block_fs_aquire_wlock( block_fs );
 
-  block_fs_unlink_file__( block_fs , filename );
+  block_fs_unlink_file__( block_fs , filename , true );
   if (block_fs_get_fragmentation( block_fs ) > block_fs->fragmentation_limit) 
     block_fs_rotate__( block_fs );
   
@@ -1313,8 +1477,12 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
     file_node_init_fwrite( node , block_fs->data_stream );                
     
     /* Writes the actual data content. */
+#ifdef ERT_HAVE_PREAD
+    util_pwrite( block_fs->data_fd , ptr , data_size , node->node_offset + node->data_offset , __func__);
+#else
     block_fs_fseek_node_data(block_fs , node);
     util_fwrite( ptr , 1 , data_size , block_fs->data_stream , __func__);
+#endif
     
     /* Writes the file node header data, including the NODE_END_TAG. */
     file_node_fwrite( node , filename , block_fs->data_stream );
@@ -1329,11 +1497,19 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
 
 
 
-static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
+/**
+   Finds a node which can hold @data_size bytes of data for
+   @filename. If the existing node for @filename is large enough it is
+   reused and *new_node is set to false, otherwise a new node is
+   returned, and the calling scope must insert it in the index after
+   it has been written.
+*/
+
+static file_node_type * block_fs_get_write_node( block_fs_type * block_fs , const char * filename , size_t data_size , bool fsync_data , bool * new_node) {
   file_node_type * file_node;
-  bool   new_node = true;   
   size_t min_size = data_size + file_node_header_size( filename );
-  
+
+  *new_node = true;
   if (block_fs_has_file__( block_fs , filename )) {
     file_node = hash_get( block_fs->index , filename );
     if (file_node->node_size < min_size) {
@@ -1346,13 +1522,20 @@ static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char
          2. Get a new node.
         
       */
-      block_fs_unlink_file__( block_fs , filename );
+      block_fs_unlink_file__( block_fs , filename , fsync_data );
       file_node = block_fs_get_new_node( block_fs , filename , min_size );
     } else
-      new_node = false;  /* We are reusing the existing node. */
+      *new_node = false;  /* We are reusing the existing node. */
   } else 
     file_node = block_fs_get_new_node( block_fs , filename , min_size );
-  
+
+  return file_node;
+}
+
+
+static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
+  bool new_node;
+  file_node_type * file_node = block_fs_get_write_node( block_fs , filename , data_size , true , &new_node );
   
   /* The actual writing ... */
   block_fs_fwrite__( block_fs , filename , file_node , ptr , data_size);
@@ -1363,6 +1546,9 @@ static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char
 
 
 void block_fs_fwrite_file(block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
+  if (block_fs_batch_fwrite( block_fs , filename , ptr , data_size ))
+    return;
+
   block_fs_aquire_wlock( block_fs );
   {
     block_fs_fwrite_file_unlocked( block_fs , filename , ptr , data_size );
@@ -1388,9 +1574,139 @@ void block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , c
 }
 
 
+static void block_fs_write_image( block_fs_type * block_fs , buffer_type * image , long int offset) {
+  if (buffer_get_size( image ) > 0) {
+#ifdef ERT_HAVE_PREAD
+    util_pwrite( block_fs->data_fd , buffer_get_data( image ) , buffer_get_size( image ) , offset , __func__);
+#else
+    block_fs_fseek( block_fs , offset );
+    util_fwrite( buffer_get_data( image ) , 1 , buffer_get_size( image ) , block_fs->data_stream , __func__);
+#endif
+  }
+  buffer_clear( image );
+}
+
+
+/*
+  Writes all the nodes in the batch; the calling scope must hold the
+  write lock. The complete image of each node is assembled in memory,
+  and nodes which are adjacent in the data file - in particular all
+  the nodes appended at the end of the file - are written with one
+  write call. The fsync() and the fragmentation check are done once
+  for the whole batch.
+*/
+
+static void block_fs_fwrite_batch__( block_fs_type * block_fs , const vector_type * batch_nodes ) {
+  buffer_type * image = buffer_alloc( 1024 * 1024 );
+  long int image_offset = 0;
+
+  /* Header updates from block_fs_unlink_file__() might still be in the stdio buffer. */
+  fflush( block_fs->data_stream );
+  for (int i = 0; i < vector_get_size( batch_nodes ); i++) {
+    const batch_node_type * batch_node = vector_iget_const( batch_nodes , i );
+    if (!batch_node->unlinked) {
+      bool new_node;
+      file_node_type * file_node = block_fs_get_write_node( block_fs , batch_node->filename , batch_node->data_size , false , &new_node );
+
+      file_node->status    = NODE_IN_USE;
+      file_node->data_size = batch_node->data_size;
+      file_node_set_data_offset( file_node , batch_node->filename );
+
+      if (file_node->node_offset != image_offset + buffer_get_size( image )) {
+        block_fs_write_image( block_fs , image , image_offset );
+        image_offset = file_node->node_offset;
+      }
+      file_node_buffer_fwrite_image( file_node , batch_node->filename , batch_node->data , image );
+
+      block_fs_update_cache_node( block_fs , file_node , batch_node->data_size , batch_node->data );
+      if (new_node)
+        block_fs_insert_index_node( block_fs , batch_node->filename , file_node );
+      block_fs->write_count++;
+    }
+  }
+  block_fs_write_image( block_fs , image , image_offset );
+  buffer_free( image );
+
+  if (block_fs->fsync_interval)
+    block_fs_fsync( block_fs );
+
+  if ((block_fs->free_size * 1.0 / block_fs->data_file_size) > block_fs->fragmentation_limit)
+    block_fs_rotate__( block_fs );
+}
+
+
+/**
+   Opens a write batch. Until the matching block_fs_commit_batch()
+   all the writes are kept in memory, and they are then written to the
+   data file in one go, with one fsync(). Reading a file which has been
+   written in the batch returns the new content; but the listing
+   functions, e.g. block_fs_alloc_filelist(), only see files which have
+   been committed.
+
+   The batches nest, and are shared between threads: the writes are
+   committed when the last open batch is committed. Open batches are
+   committed when the filesystem is closed.
+*/
+
+void block_fs_begin_batch( block_fs_type * block_fs ) {
+  if (!block_fs->data_owner)
+    util_abort("%s: tried to write to read only filesystem mounted at: %s \n",__func__ , block_fs->mount_file );
+
+  pthread_mutex_lock( &block_fs->batch_lock );
+  block_fs->batch_depth++;
+  pthread_mutex_unlock( &block_fs->batch_lock );
+}
+
+
+/*
+  The write lock is taken before the pending writes are removed from
+  the batch, that way a reader will either find the file in the batch,
+  or wait for the rlock until the batch has been written.
+*/
+
+static void block_fs_commit_batch__( block_fs_type * block_fs , bool force) {
+  vector_type * batch_nodes = NULL;
+
+  block_fs_aquire_wlock( block_fs );
+  pthread_mutex_lock( &block_fs->batch_lock );
+  {
+    if (!force) {
+      if (block_fs->batch_depth == 0)
+        util_abort("%s: no open batch in filesystem mounted at: %s \n",__func__ , block_fs->mount_file );
+      block_fs->batch_depth--;
+    }
+
+    if ((block_fs->batch_depth == 0) || force) {
+      batch_nodes = block_fs->batch_nodes;
+      block_fs->batch_nodes = vector_alloc_new();
+      hash_clear( block_fs->batch_index );
+    }
+  }
+  pthread_mutex_unlock( &block_fs->batch_lock );
+
+  if (batch_nodes != NULL) {
+    block_fs_fwrite_batch__( block_fs , batch_nodes );
+    vector_free( batch_nodes );
+  }
+  block_fs_release_rwlock( block_fs );
+}
+
+
+void block_fs_commit_batch( block_fs_type * block_fs ) {
+  block_fs_commit_batch__( block_fs , false );
+}
+
+
 /**
-   Need extra locking here - because the global rwlock allows many
-   concurrent readers.
+   When pread() is available the data is read directly from the file
+   descriptor, without using the shared file position of the data
+   stream, and any number of readers holding the global rwlock for
+   reading can proceed concurrently. The node payload is always
+   written with pwrite() in that case, so there is no data buffered in
+   the stream which the readers could miss.
+
+   Without pread() we need extra locking here - because the global
+   rwlock allows many concurrent readers.
 */
 static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * file_node , void * ptr , size_t read_bytes) {
 
@@ -1403,11 +1719,15 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
 #endif
 
   {
+#ifdef ERT_HAVE_PREAD
+    util_pread( block_fs->data_fd , ptr , read_bytes , file_node->node_offset + file_node->data_offset , __func__);
+#else
     pthread_mutex_lock( &block_fs->io_lock );
     block_fs_fseek_node_data( block_fs , file_node );
     util_fread( ptr , 1 , read_bytes , block_fs->data_stream , __func__);
     //file_node_verify_end_tag( file_node , block_fs->data_stream );
     pthread_mutex_unlock( &block_fs->io_lock );
+#endif
   }
 }
 
@@ -1417,6 +1737,9 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
 */
 
 void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * filename , buffer_type * buffer) {
+  if (block_fs_batch_fread( block_fs , filename , buffer , NULL ) >= 0)
+    return;
+
   block_fs_aquire_rlock( block_fs );
   {
     file_node_type * node = hash_get( block_fs->index , filename);
@@ -1437,11 +1760,15 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
 #endif
 
       {
+#ifdef ERT_HAVE_PREAD
+        buffer_fd_pread( buffer , node->data_size , block_fs->data_fd , node->node_offset + node->data_offset );
+#else
         pthread_mutex_lock( &block_fs->io_lock );
         block_fs_fseek_node_data(block_fs , node );
         buffer_stream_fread( buffer , node->data_size , block_fs->data_stream );
         //file_node_verify_end_tag( node , block_fs->data_stream );
         pthread_mutex_unlock( &block_fs->io_lock );
+#endif
       }
       
     }
@@ -1465,6 +1792,9 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
 
 
 void block_fs_fread_file( block_fs_type * block_fs , const char * filename , void * ptr) {
+  if (block_fs_batch_fread( block_fs , filename , NULL , ptr ) >= 0)
+    return;
+
   block_fs_aquire_rlock( block_fs );
   {
     file_node_type * node = hash_get( block_fs->index , filename);
@@ -1476,7 +1806,10 @@ void block_fs_fread_file( block_fs_type * block_fs , const char * filename , voi
 
 
 int block_fs_get_filesize( block_fs_type * block_fs , const char * filename) {
-  int data_size;
+  int data_size = block_fs_batch_fread( block_fs , filename , NULL , NULL );
+  if (data_size >= 0)
+    return data_size;
+
   block_fs_aquire_rlock( block_fs );
   {
     file_node_type * node = hash_get( block_fs->index , filename );
@@ -1540,6 +1873,9 @@ static void block_fs_dump_index( block_fs_type * block_fs ) {
 */
 
 void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
+  if (vector_get_size( block_fs->batch_nodes ) > 0)
+    block_fs_commit_batch__( block_fs , true );
+
   block_fs_fsync( block_fs );
   
   if (block_fs->data_owner) 
@@ -1575,6 +1911,8 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
   free_node_free_list( block_fs->free_nodes );
   hash_free( block_fs->index );
   vector_free( block_fs->file_nodes );
+  hash_free( block_fs->batch_index );
+  vector_free( block_fs->batch_nodes );
   free( block_fs );
 }
 
@@ -1623,8 +1961,12 @@ static void block_fs_rotate__( block_fs_type * block_fs ) {
         buffer_clear( buffer );
 
         /* Low level read of the old file. */
+#ifdef ERT_HAVE_PREAD
+        buffer_fd_pread( buffer , old_node->data_size , fileno( old_data_stream ) , old_node->node_offset + old_node->data_offset );
+#else
         fseek__( old_data_stream , old_node->node_offset + old_node->data_offset , SEEK_SET );
         buffer_stream_fread( buffer , old_node->data_size , old_data_stream );
+#endif
         
         block_fs_fwrite_file_unlocked( block_fs , key , buffer_get_data( buffer ) , buffer_get_size( buffer ));  /* Normal write to the new file. */
       }
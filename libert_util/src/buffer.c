@@ -715,6 +715,26 @@ void buffer_stream_fread( buffer_type * buffer , size_t byte_size , FILE * strea
 }
 
 
+#ifdef ERT_HAVE_PREAD
+/**
+   As buffer_stream_fread(), but the data is read from position
+   @offset in the file descriptor @fd with pread(), i.e. the file
+   position of @fd is not used.
+*/
+
+void buffer_fd_pread( buffer_type * buffer , size_t byte_size , int fd , offset_type offset) {
+  size_t min_size = byte_size + buffer->pos;
+  if (buffer->alloc_size < min_size)
+    buffer_resize__(buffer , min_size , true);
+
+  util_pread( fd , &buffer->data[buffer->pos] , byte_size , offset , __func__);
+
+  buffer->content_size += byte_size;
+  buffer->pos          += byte_size;
+}
+#endif
+
+
 
 
 /**
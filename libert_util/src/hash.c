@@ -24,7 +24,6 @@
 #include <errno.h>
 
 #include <ert/util/hash.h>
-#include <ert/util/hash_sll.h>
 #include <ert/util/hash_node.h>
 #include <ert/util/node_data.h>
 #include <ert/util/util.h>
@@ -64,13 +63,43 @@ static uint32_t hash_index(const char *key, size_t len) {
 }
 
 
+/*
+  The hash table is a flat open addressing table. Each slot has a one
+  byte control value, and a pointer to the hash_node holding the key,
+  the precomputed hash value of the key and the data.
+
+  The control byte is CTRL_EMPTY, CTRL_DELETED or - for a slot in use
+  - the lower seven bits of the hash value of the key. A lookup walks
+  the probe sequence in the control array, and only dereferences the
+  node (and compares the full hash value and the key) when the seven
+  bit tag matches; the probing ends at the first CTRL_EMPTY slot. The
+  probe sequence starts at the hash value rotated past the tag bits, and
+  continues with triangular steps: pos, pos + 1, pos + 3, pos + 6,
+  ... which visits all slots when the size is a power of two.
+
+  Deleted slots are marked CTRL_DELETED, so that the probe sequences
+  passing through them are not broken; they are reused by subsequent
+  inserts, and cleared out when the table is rehashed.
+*/
+
+#define CTRL_EMPTY    0x80
+#define CTRL_DELETED  0xFE
+#define CTRL_FREE(c)  ((c) & 0x80)
+
+#define HASH_TAG(global_index)  ((uint8_t) ((global_index) & 0x7F))
+#define HASH_POS(global_index)  (((global_index) >> 7) | ((global_index) << 25))
+
+
 struct hash_struct {
   UTIL_TYPE_ID_DECLARATION;
-  uint32_t          size;            /* This is the size of the internal table **NOT**NOT** the number of elements in the table. */
+  uint32_t          size;            /* This is the size of the internal table **NOT**NOT** the number of elements in the table. Always a power of two. */
   uint32_t          elements;        /* The number of elements in the hash table. */
+  uint32_t          deleted;         /* The number of CTRL_DELETED slots. */
   double            resize_fill;
-  hash_sll_type   **table;
+  uint8_t          *ctrl;
+  hash_node_type  **slots;
   hashf_type       *hashf;
+  bool              frozen;          /* A frozen hash can not be modified, and lookups are done without locking. */
 
   lock_type         rwlock;
 };
@@ -93,21 +122,28 @@ static void __hash_deadlock_abort(hash_type * hash) {
 
 
 static void __hash_rdlock(hash_type * hash) {
-  int lock_error = pthread_rwlock_tryrdlock( &hash->rwlock );
-  if (lock_error != 0)
-    util_abort("%s: did not get hash->read_lock - fix locking in calling scope\n",__func__);
+  if (!hash->frozen) {
+    int lock_error = pthread_rwlock_tryrdlock( &hash->rwlock );
+    if (lock_error != 0)
+      util_abort("%s: did not get hash->read_lock - fix locking in calling scope\n",__func__);
+  }
 }
 
 
 static void __hash_wrlock(hash_type * hash) {
-  int lock_error = pthread_rwlock_trywrlock( &hash->rwlock );
-  if (lock_error != 0)
-    util_abort("%s: did not get hash->write_lock - fix locking in calling scope\n",__func__);
+  if (hash->frozen)
+    util_abort("%s: tried to modify a frozen hash table\n",__func__);
+  {
+    int lock_error = pthread_rwlock_trywrlock( &hash->rwlock );
+    if (lock_error != 0)
+      util_abort("%s: did not get hash->write_lock - fix locking in calling scope\n",__func__);
+  }
 }
 
 
 static void __hash_unlock( hash_type * hash) {
-  pthread_rwlock_unlock( &hash->rwlock );
+  if (!hash->frozen)
+    pthread_rwlock_unlock( &hash->rwlock );
 }
 
 
@@ -122,7 +158,10 @@ static void LOCK_INIT( lock_type * rwlock ) {
 #else
 
 static void __hash_rdlock(hash_type * hash) {}
-static void __hash_wrlock(hash_type * hash) {}
+static void __hash_wrlock(hash_type * hash) {
+  if (hash->frozen)
+    util_abort("%s: tried to modify a frozen hash table\n",__func__);
+}
 static void __hash_unlock(hash_type * hash) {}
 static void LOCK_DESTROY(lock_type * rwlock) {}
 static void LOCK_INIT(lock_type * rwlock) {}
@@ -134,15 +173,68 @@ static void LOCK_INIT(lock_type * rwlock) {}
 /*****************************************************************/
 
 
-static void * __hash_get_node_unlocked(const hash_type *__hash , const char *key, bool abort_on_error) {
-  hash_type * hash = (hash_type *) __hash;  /* The net effect is no change - but .... ?? */
+/*
+  Returns the slot holding key, or -1 if the key is not in the table.
+*/
+
+static int hash_find_slot__(const hash_type * hash , const char * key , uint32_t global_index) {
+  const uint32_t mask = hash->size - 1;
+  const uint8_t  tag  = HASH_TAG( global_index );
+  uint32_t pos        = HASH_POS( global_index ) & mask;
+  uint32_t step;
+
+  for (step = 1; step <= hash->size; step++) {
+    uint8_t ctrl = hash->ctrl[pos];
+    if (ctrl == tag) {
+      if (hash_node_key_eq( hash->slots[pos] , global_index , key ))
+        return pos;
+    } else if (ctrl == CTRL_EMPTY)
+      return -1;
+
+    pos = (pos + step) & mask;
+  }
+  return -1;
+}
+
+
+/*
+  Returns the first free - i.e. empty or deleted - slot in the probe
+  sequence of global_index. The table is never full, so there is
+  always a free slot.
+*/
+
+static uint32_t hash_find_free_slot__(const hash_type * hash , uint32_t global_index) {
+  const uint32_t mask = hash->size - 1;
+  uint32_t pos        = HASH_POS( global_index ) & mask;
+  uint32_t step       = 1;
+
+  while (!CTRL_FREE( hash->ctrl[pos] )) {
+    pos = (pos + step) & mask;
+    step++;
+  }
+  return pos;
+}
+
+
+static void hash_set_slot__(hash_type * hash , uint32_t slot , hash_node_type * node) {
+  if (hash->ctrl[slot] == CTRL_DELETED)
+    hash->deleted--;
+
+  hash->ctrl[slot]  = HASH_TAG( hash_node_get_global_index( node ));
+  hash->slots[slot] = node;
+  hash->elements++;
+}
+
+
+static void * __hash_get_node_unlocked(const hash_type *hash , const char *key, bool abort_on_error) {
   hash_node_type * node = NULL;
   {
     const uint32_t global_index = hash->hashf(key , strlen(key));
-    const uint32_t table_index  = (global_index % hash->size);
+    int slot = hash_find_slot__( hash , key , global_index );
 
-    node = hash_sll_get(hash->table[table_index] , global_index , key);
-    if (node == NULL && abort_on_error)
+    if (slot >= 0)
+      node = hash->slots[slot];
+    else if (abort_on_error)
       util_abort("%s: tried to get from key:%s which does not exist - aborting \n",__func__ , key);
 
   }
@@ -153,7 +245,8 @@ static void * __hash_get_node_unlocked(const hash_type *__hash , const char *key
 /*
   This function looks up a hash_node from the hash. This is the common
   low-level function to get content from the hash. The function takes
-  read-lock which is held during execution.
+  read-lock which is held during execution; for a frozen hash no
+  locking is done.
 
   Would strongly preferred that the hash_type * was const - but that is
   difficult due to locking requirements.
@@ -175,6 +268,42 @@ static node_data_type * hash_get_node_data(const hash_type *hash , const char *k
 }
 
 
+static uint32_t hash_table_size(const hash_type * hash , uint32_t min_size) {
+  uint32_t size = HASH_DEFAULT_SIZE;
+  while ((size < min_size) || (size * hash->resize_fill < hash->elements + 1))
+    size *= 2;
+  return size;
+}
+
+
+/*
+  Moves all the nodes over to a new table with new_size slots, the
+  deleted slots are dropped in the process.
+*/
+
+static void hash_rehash__(hash_type * hash , uint32_t new_size) {
+  uint8_t         * old_ctrl  = hash->ctrl;
+  hash_node_type ** old_slots = hash->slots;
+  uint32_t          old_size  = hash->size;
+  uint32_t i;
+
+  hash->size     = new_size;
+  hash->ctrl     = util_malloc( new_size * sizeof * hash->ctrl );
+  hash->slots    = util_calloc( new_size , sizeof * hash->slots );
+  hash->elements = 0;
+  hash->deleted  = 0;
+  memset( hash->ctrl , CTRL_EMPTY , new_size * sizeof * hash->ctrl );
+
+  for (i=0; i < old_size; i++) {
+    if (!CTRL_FREE( old_ctrl[i] )) {
+      hash_node_type * node = old_slots[i];
+      hash_set_slot__( hash , hash_find_free_slot__( hash , hash_node_get_global_index( node )) , node );
+    }
+  }
+
+  free( old_ctrl );
+  free( old_slots );
+}
 
 
 /**
@@ -184,37 +313,14 @@ static node_data_type * hash_get_node_data(const hash_type *hash , const char *k
 
    If you know in advance (roughly) how large the hash table will be
    it can be advantageous to call hash_resize() manually, to avoid
-   repeated internal calls to hash_resize().
+   repeated internal calls to hash_resize(). The size is rounded up to
+   a power of two.
 */
 
 void hash_resize(hash_type *hash, int new_size) {
-  hash_sll_type ** new_table = hash_sll_alloc_table( new_size );
-  hash_node_type * node;
-  uint32_t i;
-
-  for (i=0; i < hash->size; i++) {
-    node = hash_sll_get_head(hash->table[i]);
-    while (node != NULL) {
-      uint32_t new_table_index  = hash_node_set_table_index(node , new_size);
-      hash_node_type *next_node = hash_node_get_next(node);
-      hash_sll_add_node(new_table[new_table_index] , node);
-      node = next_node;
-    }
-  }
-
-  /*
-     Only freeing the table structure, *NOT* calling the node_free()
-     functions, which happens when hash_sll_free() is called.
-  */
-
-  {
-    for (i=0; i < hash->size; i++)
-      free( hash->table[i] );
-    free( hash->table );
-  }
-
-  hash->size     = new_size;
-  hash->table    = new_table;
+  uint32_t size = hash_table_size( hash , new_size );
+  if (size > hash->size)
+    hash_rehash__( hash , size );
 }
 
 
@@ -227,23 +333,26 @@ void hash_resize(hash_type *hash, int new_size) {
 static void __hash_insert_node(hash_type *hash , hash_node_type *node) {
   __hash_wrlock( hash );
   {
-    uint32_t table_index = hash_node_get_table_index(node);
-    {
+    const uint32_t global_index = hash_node_get_global_index( node );
+    int slot = hash_find_slot__( hash , hash_node_get_key( node ) , global_index );
+
+    if (slot >= 0) {
       /*
         If a node with the same key already exists in the table
-        it is removed.
+        it is replaced.
       */
-      hash_node_type *existing_node = __hash_get_node_unlocked(hash , hash_node_get_key(node) , false);
-      if (existing_node != NULL) {
-        hash_sll_del_node(hash->table[table_index] , existing_node);
-        hash->elements--;
+      hash_node_free( hash->slots[slot] );
+      hash->slots[slot] = node;
+    } else {
+      if ((1.0 * (hash->elements + hash->deleted + 1) / hash->size) > hash->resize_fill) {
+        /* Grow if the table is full of live nodes, otherwise the rehash just clears out the deleted slots. */
+        if ((1.0 * (hash->elements + 1) / hash->size) > 0.5 * hash->resize_fill)
+          hash_rehash__( hash , hash->size * 2 );
+        else
+          hash_rehash__( hash , hash->size );
       }
+      hash_set_slot__( hash , hash_find_free_slot__( hash , global_index ) , node );
     }
-
-    hash_sll_add_node(hash->table[table_index] , node);
-    hash->elements++;
-    if ((1.0 * hash->elements / hash->size) > hash->resize_fill)
-      hash_resize(hash , hash->size * 2);
   }
   __hash_unlock( hash );
 }
@@ -253,46 +362,24 @@ static void __hash_insert_node(hash_type *hash , hash_node_type *node) {
 /**
    This function deletes a node from the hash_table. Observe that this
    function does *NOT* do any locking - it is the repsonsibility of
-   the calling functions: hash_del() and hash_clear() to take the
+   the calling functions: hash_del() and hash_safe_del() to take the
    necessary write lock.
 */
 
 
 static void hash_del_unlocked__(hash_type *hash , const char *key) {
   const uint32_t global_index = hash->hashf(key , strlen(key));
-  const uint32_t table_index  = (global_index % hash->size);
-  hash_node_type *node        = hash_sll_get(hash->table[table_index] , global_index , key);
+  int slot = hash_find_slot__( hash , key , global_index );
 
-  if (node == NULL)
+  if (slot < 0)
     util_abort("%s: hash does not contain key:%s - aborting \n",__func__ , key);
-  else
-    hash_sll_del_node(hash->table[table_index] , node);
-
-  hash->elements--;
-}
-
-
-
-/**
-   This functions takes a hash_node and finds the "next" hash node by
-   traversing the internal hash structure. Should NOT be confused with
-   the other functions providing iterations to user-space.
-*/
-
-static hash_node_type * hash_internal_iter_next(const hash_type *hash , const hash_node_type * node) {
-  hash_node_type *next_node = hash_node_get_next(node);
-  if (next_node == NULL) {
-    const uint32_t table_index = hash_node_get_table_index(node);
-    if (table_index < hash->size) {
-      uint32_t i = table_index + 1;
-      while (i < hash->size && hash_sll_empty(hash->table[i]))
-        i++;
-
-      if (i < hash->size)
-        next_node = hash_sll_get_head(hash->table[i]);
-    }
+  else {
+    hash_node_free( hash->slots[slot] );
+    hash->slots[slot] = NULL;
+    hash->ctrl[slot]  = CTRL_DELETED;
+    hash->deleted++;
+    hash->elements--;
   }
-  return next_node;
 }
 
 
@@ -315,22 +402,13 @@ static char ** hash_alloc_keylist__(hash_type *hash , bool lock) {
   {
     if (hash->elements > 0) {
       int i = 0;
-      hash_node_type *node = NULL;
+      uint32_t slot;
       keylist = calloc(hash->elements , sizeof *keylist);
-      {
-        uint32_t i = 0;
-        while (i < hash->size && hash_sll_empty(hash->table[i]))
+      for (slot = 0; slot < hash->size; slot++) {
+        if (!CTRL_FREE( hash->ctrl[slot] )) {
+          keylist[i] = util_alloc_string_copy( hash_node_get_key( hash->slots[slot] ));
           i++;
-
-        if (i < hash->size)
-          node = hash_sll_get_head(hash->table[i]);
-      }
-
-      while (node != NULL) {
-        const char *key = hash_node_get_key(node);
-        keylist[i] = util_alloc_string_copy(key);
-        node = hash_internal_iter_next(hash , node);
-        i++;
+        }
       }
     } else keylist = NULL;
   }
@@ -339,6 +417,23 @@ static char ** hash_alloc_keylist__(hash_type *hash , bool lock) {
 }
 
 
+/*
+  Frees all the nodes, and leaves the table empty. No locking.
+*/
+
+static void hash_clear_unlocked__(hash_type * hash) {
+  uint32_t slot;
+  for (slot = 0; slot < hash->size; slot++) {
+    if (!CTRL_FREE( hash->ctrl[slot] ))
+      hash_node_free( hash->slots[slot] );
+    hash->slots[slot] = NULL;
+  }
+  memset( hash->ctrl , CTRL_EMPTY , hash->size * sizeof * hash->ctrl );
+  hash->elements = 0;
+  hash->deleted  = 0;
+}
+
+
 
 
 
@@ -352,7 +447,7 @@ static char ** hash_alloc_keylist__(hash_type *hash , bool lock) {
 
 void hash_insert_string(hash_type * hash , const char * key , const char * value) {
   node_data_type * node_data = node_data_alloc_string( value );
-  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf , hash->size);
+  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf);
   __hash_insert_node(hash , hash_node);
 }
 
@@ -365,7 +460,7 @@ char * hash_get_string(const hash_type * hash , const char * key) {
 
 void hash_insert_int(hash_type * hash , const char * key , int value) {
   node_data_type * node_data = node_data_alloc_int( value );
-  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf , hash->size);
+  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf);
   __hash_insert_node(hash , hash_node);
 }
 
@@ -411,7 +506,7 @@ int hash_get_counter(const hash_type * hash , const char * key) {
 
 void hash_insert_double(hash_type * hash , const char * key , double value) {
   node_data_type * node_data = node_data_alloc_double( value );
-  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf , hash->size);
+  hash_node_type * hash_node = hash_node_alloc_new(key , node_data , hash->hashf);
   __hash_insert_node(hash , hash_node);
 }
 
@@ -444,18 +539,7 @@ void hash_safe_del(hash_type * hash , const char * key) {
 
 void hash_clear(hash_type *hash) {
   __hash_wrlock( hash );
-  {
-    int old_size = hash_get_size(hash);
-    if (old_size > 0) {
-      char **keyList = hash_alloc_keylist__( hash , false);
-      int i;
-      for (i=0; i < old_size; i++) {
-        hash_del_unlocked__(hash , keyList[i]);
-        free(keyList[i]);
-      }
-      free(keyList);
-    }
-  }
+  hash_clear_unlocked__( hash );
   __hash_unlock( hash );
 }
 
@@ -513,9 +597,13 @@ static hash_type * __hash_alloc(int size, double resize_fill , hashf_type *hashf
   UTIL_TYPE_ID_INIT(hash , HASH_TYPE_ID);
   hash->size      = size;
   hash->hashf     = hashf;
-  hash->table     = hash_sll_alloc_table(hash->size);
+  hash->ctrl      = util_malloc( size * sizeof * hash->ctrl );
+  hash->slots     = util_calloc( size , sizeof * hash->slots );
   hash->elements  = 0;
+  hash->deleted   = 0;
+  hash->frozen    = false;
   hash->resize_fill  = resize_fill;
+  memset( hash->ctrl , CTRL_EMPTY , size * sizeof * hash->ctrl );
   LOCK_INIT( &hash->rwlock );
 
   return hash;
@@ -538,10 +626,9 @@ UTIL_SAFE_CAST_FUNCTION_CONST( hash , HASH_TYPE_ID)
 UTIL_IS_INSTANCE_FUNCTION(hash , HASH_TYPE_ID)
 
 void hash_free(hash_type *hash) {
-  uint32_t i;
-  for (i=0; i < hash->size; i++)
-    hash_sll_free(hash->table[i]);
-  free(hash->table);
+  hash_clear_unlocked__( hash );
+  free( hash->ctrl );
+  free( hash->slots );
   LOCK_DESTROY( &hash->rwlock );
   free(hash);
 }
@@ -552,6 +639,26 @@ void hash_free__(void * void_hash) {
 }
 
 
+/**
+   Freezes the hash table; after this the table can not be modified
+   any more - inserting or deleting will abort - and lookups are done
+   without any locking, so that any number of threads can read from
+   the table concurrently. The hash must be frozen before it is shared
+   between threads.
+*/
+
+void hash_freeze(hash_type * hash) {
+  __hash_wrlock( hash );
+  __hash_unlock( hash );
+  hash->frozen = true;
+}
+
+
+bool hash_is_frozen(const hash_type * hash) {
+  return hash->frozen;
+}
+
+
 char ** hash_alloc_keylist(hash_type *hash) {
   return hash_alloc_keylist__(hash , true);
 }
@@ -596,7 +703,7 @@ void hash_insert_copy(hash_type *hash , const char *key , const void *value , co
     util_abort("%s: must provide copy constructer and delete operator for insert copy - aborting \n",__func__);
   {
     node_data_type * data_node = node_data_alloc_ptr( value , copyc , del );
-    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf , hash->size);
+    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf);
     __hash_insert_node(hash , hash_node);
   }
 }
@@ -619,7 +726,7 @@ void hash_insert_hash_owned_ref(hash_type *hash , const char *key , const void *
     util_abort("%s: must provide delete operator for insert hash_owned_ref - aborting \n",__func__);
   {
     node_data_type * data_node = node_data_alloc_ptr( value , NULL , del );
-    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf , hash->size);
+    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf);
     __hash_insert_node(hash , hash_node);
   }
 }
@@ -629,7 +736,7 @@ void hash_insert_ref(hash_type *hash , const char *key , const void *value) {
   hash_node_type *hash_node;
   {
     node_data_type * data_node = node_data_alloc_ptr( value , NULL , NULL);
-    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf , hash->size);
+    hash_node                  = hash_node_alloc_new(key , data_node , hash->hashf);
     __hash_insert_node(hash , hash_node);
   }
 }
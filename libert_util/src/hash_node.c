@@ -33,9 +33,7 @@ extern "C" {
 struct hash_node_struct {
   char             *key;
   uint32_t          global_index;
-  uint32_t          table_index;
   node_data_type   *data;
-  hash_node_type   *next_node;
 };
   
 
@@ -52,10 +50,6 @@ bool hash_node_key_eq(const hash_node_type * node , uint32_t global_index , cons
 }
 
 
-uint32_t hash_node_get_table_index(const hash_node_type * node)  { 
-  return node->table_index; 
-}
-
 uint32_t hash_node_get_global_index(const hash_node_type * node) { 
   return node->global_index; 
 }
@@ -64,22 +58,6 @@ const char * hash_node_get_key(const hash_node_type * node) {
   return node->key; 
 }
 
-hash_node_type * hash_node_get_next(const hash_node_type * node) { 
-  return node->next_node; 
-}
-
-
-void hash_node_set_next(hash_node_type *node , const hash_node_type *next_node) {
-  node->next_node = (hash_node_type *) next_node;
-}
-
-
-uint32_t hash_node_set_table_index(hash_node_type *node , uint32_t table_size) {
-  node->table_index = (node->global_index % table_size);
-  return node->table_index;
-}
-
-
 /*****************************************************************/
 /* The three functions below here are the only functions accessing the
    data field of the hash_node.  
@@ -90,15 +68,12 @@ node_data_type * hash_node_get_data(const hash_node_type * node) {
 }
 
 
-hash_node_type * hash_node_alloc_new(const char *key, node_data_type * data, hashf_type *hashf , uint32_t table_size) {
+hash_node_type * hash_node_alloc_new(const char *key, node_data_type * data, hashf_type *hashf) {
   hash_node_type *node;
   node              = util_malloc(sizeof *node );
   node->key         = util_alloc_string_copy( key );
   node->data        = data;
-  node->next_node   = NULL;
-        
   node->global_index = hashf(node->key , strlen(node->key));
-  hash_node_set_table_index(node , table_size);
   return node;
 }
 
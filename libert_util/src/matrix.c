@@ -28,6 +28,9 @@
 #include <ert/util/matrix.h>
 #include <ert/util/arg_pack.h>
 #include <ert/util/rng.h>
+#ifdef ERT_HAVE_LAPACK
+#include <ert/util/matrix_blas.h>
+#endif
 
 /**
    This is V E R Y  S I M P L E matrix implementation. It is not
@@ -1067,32 +1070,95 @@ matrix_type * matrix_alloc_transpose( const matrix_type * A) {
    For general matrix multiplactions where A = B * C all have
    different dimensions you can use matrix_matmul() (which calls the
    BLAS routine dgemm());
+
+   The rows of A are updated in blocks of MATRIX_MATMUL_BLOCK_ROWS
+   rows; the current block is copied to a contiguous column major
+   work buffer before it is multiplied with B. When BLAS is available
+   (and both matrices have unit row stride) the block product is
+   evaluated with dgemm(), otherwise with a plain loop where the
+   innermost loop runs over consecutive rows in the work buffer, so
+   that the compiler can vectorize it.
 */
 
+#define MATRIX_MATMUL_BLOCK_ROWS 256
 
-void matrix_inplace_matmul(matrix_type * A, const matrix_type * B) {
-  if ((A->columns == B->rows) && (B->rows == B->columns)) {
-    double * tmp = util_malloc( sizeof * A->data * A->columns );
-    int i,j,k;
+static void matrix_inplace_matmul_block(matrix_type * A, const matrix_type * B , int row_offset , int block_rows , double * work , double * column) {
+  const int n = B->rows;
+  int i,j,k;
 
-    for (i=0; i < A->rows; i++) {
+  for (k=0; k < n; k++)
+    for (i=0; i < block_rows; i++)
+      work[ k * block_rows + i ] = A->data[ GET_INDEX(A , row_offset + i , k) ];
+
+  for (j=0; j < n; j++) {
+    for (i=0; i < block_rows; i++)
+      column[i] = 0;
+
+    for (k=0; k < n; k++) {
+      const double   b      = B->data[ GET_INDEX(B , k , j) ];
+      const double * work_k = &work[ k * block_rows ];
+      for (i=0; i < block_rows; i++)
+        column[i] += work_k[i] * b;
+    }
+
+    for (i=0; i < block_rows; i++)
+      A->data[ GET_INDEX(A , row_offset + i , j) ] = column[i];
+  }
+}
+
+
+#ifdef ERT_HAVE_LAPACK
+
+static void matrix_inplace_matmul_dgemm(matrix_type * A, const matrix_type * B) {
+  const int n = B->rows;
+  int row_offset = 0;
+  matrix_type * work;
 
-      /* Clearing the tmp vector */
-      for (k=0; k < B->rows; k++)
-        tmp[k] = 0;
+  if (A->rows == 0)
+    return;
 
-      for (j=0; j < B->rows; j++) {
-        double scalar_product = 0;
-        for (k=0; k < A->columns; k++)
-          scalar_product += A->data[ GET_INDEX(A,i,k) ] * B->data[ GET_INDEX(B,k,j) ];
+  work = matrix_alloc( util_int_min( MATRIX_MATMUL_BLOCK_ROWS , A->rows ) , n );
 
-        /* Assign first to tmp[j] */
-        tmp[j] = scalar_product;
+  while (row_offset < A->rows) {
+    int block_rows = util_int_min( MATRIX_MATMUL_BLOCK_ROWS , A->rows - row_offset );
+    matrix_type * A_block = matrix_alloc_shared( A , row_offset , 0 , block_rows , n );
+
+    if (block_rows != matrix_get_rows( work ))
+      matrix_resize( work , block_rows , n , false );
+
+    matrix_assign( work , A_block );
+    matrix_dgemm( A_block , work , B , false , false , 1 , 0 );
+    matrix_free( A_block );
+    row_offset += block_rows;
+  }
+  matrix_free( work );
+}
+
+#endif
+
+
+void matrix_inplace_matmul(matrix_type * A, const matrix_type * B) {
+  if ((A->columns == B->rows) && (B->rows == B->columns)) {
+#ifdef ERT_HAVE_LAPACK
+    if ((A->row_stride == 1) && (B->row_stride == 1)) {
+      matrix_inplace_matmul_dgemm( A , B );
+      return;
+    }
+#endif
+    {
+      double * work   = util_malloc( MATRIX_MATMUL_BLOCK_ROWS * B->rows * sizeof * work );
+      double * column = util_malloc( MATRIX_MATMUL_BLOCK_ROWS * sizeof * column );
+      int row_offset = 0;
+
+      while (row_offset < A->rows) {
+        int block_rows = util_int_min( MATRIX_MATMUL_BLOCK_ROWS , A->rows - row_offset );
+        matrix_inplace_matmul_block( A , B , row_offset , block_rows , work , column );
+        row_offset += block_rows;
       }
-      for (j=0; j < A->columns; j++)
-        A->data[ GET_INDEX(A , i, j) ] = tmp[j];
+
+      free( column );
+      free( work );
     }
-    free(tmp);
   } else
     util_abort("%s: size mismatch: A:[%d,%d]   B:[%d,%d]\n",__func__ , matrix_get_rows(A) , matrix_get_columns(A) , matrix_get_rows(B) , matrix_get_columns(B));
 }
@@ -23,6 +23,9 @@
 #include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
 
 #include "ert/util/build_config.h"
 
@@ -32,15 +35,22 @@
 
 
 /**
-   This file implements a small thread_pool object based on
-   pthread_create() function calls. The characetristics of this
+   This file implements a small thread_pool object based on a fixed
+   set of persistent worker threads. The characetristics of this
    implementation is as follows:
 
-    1. The jobs are mangaged by a separate thread - dispatch_thread.
-    2. The new jobs are just appended to the queue, the
-       dispatch_thread sees them in the queue and dispatches them.
-    3. The dispatch thread manages a list of thread_pool_job_slot_type
-       instances - one slot for each actually running job.
+    1. The max_running worker threads are created when the pool is
+       allocated, and live until thread_pool_free(); there is no
+       pthread_create() call per job.
+    2. Each worker has its own deque of jobs. Jobs added from a
+       thread outside the pool go into a shared submit deque, jobs
+       added from within a running job - i.e. nested jobs - go into
+       the deque of the worker running the job.
+    3. A worker runs the most recently added job from its own deque
+       first; when that is empty it takes the oldest job from the
+       submit deque, and finally it will steal the oldest job from the
+       deque of one of the other workers.
+    4. Idle workers sleep on a condition variable.
 
    Example
    -------
@@ -65,6 +75,11 @@
       (void *) pointer as output. The thread pool implementation does
       not touch the input and output of some_function.
 
+      The return value from thread_pool_add_job() is the queue index
+      of the job, which can be used to wait for that particular job
+      with thread_pool_wait_job(). A running job can add more jobs to
+      the pool, and wait for them.
+
 
   3.  When all the jobs have been added you inform the thread pool of
       that by calling:
@@ -72,7 +87,8 @@
          thread_pool_join( tp );
 
       This function will not return before all the added jobs have run
-      to completion.
+      to completion. thread_pool_join() can not be called from a job
+      running in the pool; use thread_pool_wait_job() for that.
 
 
   4. Optional: If you want to get the return value from the function
@@ -90,6 +106,10 @@
 
   6. When you are really finished: thread_pool_free( tp );
 
+
+   For loops over an index range there is the helper
+   thread_pool_parallel_for() which splits the range in chunks, runs
+   them in the pool and waits for them to complete.
 */
 
 
@@ -100,205 +120,254 @@ typedef void * (start_func_ftype) (void *) ;
    Internal struct which is used as queue node.
 */
 typedef struct {
-  thread_pool_type * pool;                /* A back-reference to the thread_pool holding the queue. */
-  int                slot_index;          /* The index in the space [0,max_running) of the job slot where this job is running. */
-  int                queue_index;         /* The index of the current tp_arg in the queue. */
   void             * func_arg;            /* The arguments to this job - supplied by the calling scope. */
   start_func_ftype * func;                /* The function to call - supplied by the calling scope. */
-  void             * return_value;
-} thread_pool_arg_type;
+  int                queue_index;         /* The index of the job in the results vector. */
+} thread_pool_job_type;
 
 
+typedef struct {
+  void             * return_value;
+  bool               complete;
+} thread_pool_result_type;
+
 
 /**
-   Internal struct used to keep track of the job slots.
+   A double ended queue of jobs, implemented as a ring buffer. The
+   owner pushes and pops at the tail, other threads take jobs from the
+   head.
 */
 typedef struct {
-  pthread_t  thread;                /* The thread variable currently (or more correct:last) running. */
-  int        run_count;             /* The number of times this slot has been used - just to check whether the slot has been used AT ALL when/if joining. */
-  bool       running;               /* Is the job_slot running now?? */
-} thread_pool_job_slot_type;
+  pthread_mutex_t        lock;
+  thread_pool_job_type * jobs;
+  int                    head;
+  int                    size;
+  int                    alloc_size;
+} thread_pool_deque_type;
+
 
+typedef struct {
+  thread_pool_type       * pool;
+  int                      worker_index;
+  pthread_t                thread;
+  thread_pool_deque_type   deque;
+} thread_pool_worker_type;
 
 
 
 #define THREAD_POOL_TYPE_ID 71443207
 struct thread_pool_struct {
   UTIL_TYPE_ID_DECLARATION;
-  thread_pool_arg_type      * queue;              /* The jobs to be executed are appended in this vector. */
-  int                         queue_index;        /* The index of the next job to run. */
-  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. [Should be protected / atomic / ... ] */
-  int                         queue_alloc_size;   /* The allocated size of the queue. */
-
-  int                         max_running;        /* The max number of concurrently running jobs. */
-  bool                        join;               /* Flag set by the main thread to inform the dispatch thread that joining should start. */
-  bool                        accepting_jobs;     /* True|False whether the dispatch thread is running. */
-
-  thread_pool_job_slot_type * job_slots;          /* A vector to @max_running job slots, each slot can be reused several times.*/
-  pthread_t                   dispatch_thread;
-  pthread_rwlock_t            queue_lock;
+  int                         max_running;        /* The number of worker threads. */
+  thread_pool_worker_type   * workers;
+  thread_pool_deque_type      submit_deque;       /* Jobs added from threads which are not workers in this pool. */
+
+  pthread_mutex_t             lock;               /* Protects the counters, flags and results below. */
+  pthread_cond_t              work_cond;          /* Signalled when jobs are added, and on shutdown. */
+  pthread_cond_t              done_cond;          /* Signalled when jobs complete. */
+  int                         queued;             /* The number of jobs waiting in the deques. */
+  int                         pending;            /* The number of jobs added, and not yet completed. */
+  int                         helpers_waiting;    /* The number of workers in thread_pool_wait_job() waiting for jobs to help with. */
+  bool                        accepting_jobs;     /* True|False whether the pool has been (re)started and not joined. */
+  bool                        shutdown;
+
+  thread_pool_result_type   * results;
+  int                         queue_size;         /* The number of jobs added since the last restart. */
+  int                         queue_alloc_size;   /* The allocated size of the results vector. */
 };
 
 
-static UTIL_SAFE_CAST_FUNCTION( thread_pool , THREAD_POOL_TYPE_ID )
+
+/* The worker - if any - running in the current thread. */
+static __thread thread_pool_worker_type * current_worker = NULL;
+
+
+/*****************************************************************/
+
+static void thread_pool_deque_init( thread_pool_deque_type * deque ) {
+  pthread_mutex_init( &deque->lock , NULL );
+  deque->alloc_size = 32;
+  deque->jobs = util_calloc( deque->alloc_size , sizeof * deque->jobs );
+  deque->head = 0;
+  deque->size = 0;
+}
+
+
+static void thread_pool_deque_free( thread_pool_deque_type * deque ) {
+  pthread_mutex_destroy( &deque->lock );
+  free( deque->jobs );
+}
+
+
+static void thread_pool_deque_push( thread_pool_deque_type * deque , const thread_pool_job_type * job ) {
+  pthread_mutex_lock( &deque->lock );
+  {
+    if (deque->size == deque->alloc_size) {
+      int new_size = 2 * deque->alloc_size;
+      thread_pool_job_type * jobs = util_calloc( new_size , sizeof * jobs );
+      for (int i = 0; i < deque->size; i++)
+        jobs[i] = deque->jobs[ (deque->head + i) % deque->alloc_size ];
+
+      free( deque->jobs );
+      deque->jobs = jobs;
+      deque->head = 0;
+      deque->alloc_size = new_size;
+    }
+    deque->jobs[ (deque->head + deque->size) % deque->alloc_size ] = *job;
+    deque->size++;
+  }
+  pthread_mutex_unlock( &deque->lock );
+}
+
+
+static bool thread_pool_deque_pop_tail( thread_pool_deque_type * deque , thread_pool_job_type * job ) {
+  bool found = false;
+  pthread_mutex_lock( &deque->lock );
+  if (deque->size > 0) {
+    deque->size--;
+    *job = deque->jobs[ (deque->head + deque->size) % deque->alloc_size ];
+    found = true;
+  }
+  pthread_mutex_unlock( &deque->lock );
+  return found;
+}
+
+
+static bool thread_pool_deque_pop_head( thread_pool_deque_type * deque , thread_pool_job_type * job ) {
+  bool found = false;
+  pthread_mutex_lock( &deque->lock );
+  if (deque->size > 0) {
+    *job = deque->jobs[ deque->head ];
+    deque->head = (deque->head + 1) % deque->alloc_size;
+    deque->size--;
+    found = true;
+  }
+  pthread_mutex_unlock( &deque->lock );
+  return found;
+}
+
+
+/*****************************************************************/
 
 
 /**
-   This function will grow the queue. It is called by the main thread
-   (i.e. the context of the calling scope), and the queue is read by
-   the dispatch_thread - i.e. access to the queue must be protected by
-   rwlock.
+   Reserves a slot for the job in the results vector, and returns the
+   queue index of the job. The results vector is updated by the
+   executing threads, all access goes through the pool lock.
 */
 
-static void thread_pool_resize_queue( thread_pool_type * pool, int queue_length ) {
-  pthread_rwlock_wrlock( &pool->queue_lock );
+static int thread_pool_alloc_queue_index( thread_pool_type * pool ) {
+  int queue_index;
+  pthread_mutex_lock( &pool->lock );
   {
-    pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
-    pool->queue_alloc_size = queue_length;
+    queue_index = pool->queue_size;
+    if (queue_index == pool->queue_alloc_size) {
+      pool->queue_alloc_size *= 2;
+      pool->results = util_realloc( pool->results , pool->queue_alloc_size * sizeof * pool->results );
+    }
+    pool->results[ queue_index ].return_value = NULL;
+    pool->results[ queue_index ].complete = false;
+    pool->queue_size++;
   }
-  pthread_rwlock_unlock( &pool->queue_lock );
+  pthread_mutex_unlock( &pool->lock );
+  return queue_index;
 }
 
 
 /**
-   This function updates an element in the queue, the function is
-   called by the executing threads, on the same time the main thread
-   might be resizing the thread, we therefor take a read lock during
-   execution of this function. (Write lock is not necessary because we
-   will not change the queue pointer itself, only something it points
-   to.)
+   Stores the return value, marks the job as complete and wakes up the
+   threads waiting for jobs to complete.
 */
 
-static void thread_pool_iset_return_value( thread_pool_type * pool , int index , void * return_value) {
-  pthread_rwlock_rdlock( &pool->queue_lock );
+static void thread_pool_complete_job( thread_pool_type * pool , int index , void * return_value) {
+  pthread_mutex_lock( &pool->lock );
   {
-    pool->queue[ index ].return_value = return_value;
+    pool->results[ index ].return_value = return_value;
+    pool->results[ index ].complete = true;
+    pool->pending--;
+    pthread_cond_broadcast( &pool->done_cond );
   }
-  pthread_rwlock_unlock( &pool->queue_lock );
+  pthread_mutex_unlock( &pool->lock );
 }
 
 
 void * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_index ) {
-  return pool->queue[ queue_index ].return_value;
+  return pool->results[ queue_index ].return_value;
 }
 
 
 /**
-   The pthread_create() call which this is all about, does not start
-   the user supplied function. Instead it will start an instance of
-   this function, which will do some housekeeping before calling the
-   user supplied function.
+   Finds the next job for the worker: first from the tail of its own
+   deque, then from the head of the submit deque, and finally by
+   stealing from the head of the other workers' deques. The worker
+   argument can be NULL.
 */
 
-static void * thread_pool_start_job( void * arg ) {
-  thread_pool_arg_type * tp_arg = (thread_pool_arg_type * ) arg;
-  thread_pool_type * tp         =  tp_arg->pool;
-  int slot_index                =  tp_arg->slot_index;
-  void * func_arg               =  tp_arg->func_arg;
-  start_func_ftype * func       =  tp_arg->func;
-  void * return_value;
+static bool thread_pool_find_job( thread_pool_type * pool , thread_pool_worker_type * worker , thread_pool_job_type * job ) {
+  bool found = false;
+  int self = -1;
 
+  if (worker != NULL) {
+    self = worker->worker_index;
+    found = thread_pool_deque_pop_tail( &worker->deque , job );
+  }
 
-  return_value = func( func_arg );                  /* Starting the real external function */
-  tp->job_slots[ slot_index ].running = false;      /* We mark the job as completed. */
-  free( arg );
+  if (!found)
+    found = thread_pool_deque_pop_head( &pool->submit_deque , job );
 
-  if (return_value != NULL)
-    thread_pool_iset_return_value( tp , tp_arg->queue_index , return_value);
+  for (int i = 1; !found && (i <= pool->max_running); i++) {
+    int victim = (self + i + pool->max_running) % pool->max_running;
+    if (victim != self)
+      found = thread_pool_deque_pop_head( &pool->workers[victim].deque , job );
+  }
 
-  return NULL;
+  if (found)
+    __atomic_fetch_sub( &pool->queued , 1 , __ATOMIC_SEQ_CST );
+
+  return found;
+}
+
+
+static void thread_pool_run_job( thread_pool_type * pool , const thread_pool_job_type * job ) {
+  void * return_value = job->func( job->func_arg );     /* Starting the real external function */
+  thread_pool_complete_job( pool , job->queue_index , return_value );
 }
 
 
+static int thread_pool_get_queued( const thread_pool_type * pool ) {
+  return __atomic_load_n( &pool->queued , __ATOMIC_SEQ_CST );
+}
+
 
 /**
-   This function is run by the dispatch_thread. The thread will keep
-   an eye on the queue, and dispatch new jobs when there are free
-   slots available.
+   This function is run by each of the worker threads; the worker will
+   run jobs as long as it can find any, and sleep on work_cond when
+   all the deques are empty.
 */
 
-static void * thread_pool_main_loop( void * arg ) {
-  thread_pool_type * tp = thread_pool_safe_cast( arg );
-  {
-    const int usleep_init = 1000;  /* The sleep time when there are free slots available - but no jobs wanting to run. */
-    int internal_offset   = 0;     /* Keep track of the (index of) the last job slot fired off - minor time saving. */
-    while (true) {
-      if (tp->queue_size > tp->queue_index) {
-        /*
-           There are jobs in the queue which would like to run -
-           let us see if we can find a slot for them.
-        */
-        int counter     = 0;
-        bool slot_found = false;
-        do {
-          int slot_index = (counter + internal_offset) % tp->max_running;
-          thread_pool_job_slot_type * job_slot = &tp->job_slots[ slot_index ];
-          if (!job_slot->running) {
-            /* OK thread[slot_index] is ready to take this job.*/
-            thread_pool_arg_type * tp_arg;
-
-            /*
-               The queue might be updated by the main thread - we must
-               take a copy of the node we are interested in.
-            */
-            pthread_rwlock_rdlock( &tp->queue_lock );
-            tp_arg = util_alloc_copy( &tp->queue[ tp->queue_index ] , sizeof * tp_arg );
-            pthread_rwlock_unlock( &tp->queue_lock );
-
-            tp_arg->slot_index = slot_index;
-            job_slot->running = true;
-            /*
-               Here is the actual pthread_create() call creating an
-               additional running thread.
-            */
-
-            /*Cleanup of previous run threads. Needed to avoid memory leak*/
-            if (job_slot->run_count > 0)
-              pthread_join(job_slot->thread, NULL);
-
-            pthread_create( &job_slot->thread , NULL , thread_pool_start_job , tp_arg );
-            job_slot->run_count += 1;
-            tp->queue_index++;
-            internal_offset += (counter + 1);
-            slot_found = true;
-          } else
-            counter++;
-        } while (!slot_found && (counter < tp->max_running));
-
-        if (!slot_found) {
-            util_yield();
-        }
-      } else
-        util_usleep(usleep_init);    /* There are no jobs wanting to run. */
-
-      /*****************************************************************/
-      /*
-        We exit explicitly from this loop when both conditions apply:
-
-         1. tp->join       == true              :  The calling scope has signaled that it will not submit more jobs.
-         2. tp->queue_size == tp->queue_index   :  This function has submitted all the jobs in the queue.
-      */
-      if ((tp->join) && (tp->queue_size == tp->queue_index))
+static void * thread_pool_worker_main( void * arg ) {
+  thread_pool_worker_type * worker = (thread_pool_worker_type *) arg;
+  thread_pool_type * pool = worker->pool;
+
+  current_worker = worker;
+  while (true) {
+    thread_pool_job_type job;
+    if (thread_pool_find_job( pool , worker , &job ))
+      thread_pool_run_job( pool , &job );
+    else {
+      bool exit_worker = false;
+      pthread_mutex_lock( &pool->lock );
+      while ((thread_pool_get_queued( pool ) <= 0) && !pool->shutdown)
+        pthread_cond_wait( &pool->work_cond , &pool->lock );
+
+      if (pool->shutdown && (thread_pool_get_queued( pool ) <= 0))
+        exit_worker = true;
+      pthread_mutex_unlock( &pool->lock );
+
+      if (exit_worker)
         break;
-    } /* End of while() loop */
-  }
-
-  /*
-     There are no more jobs in the queue, and the main scope has
-     signaled that join should start. Observe that we join only the
-     jobs corresponding to explicitly running job_slots; when a job
-     slot is used multiple times the first jobs run in the job_slot
-     will not be explicitly joined.
-  */
-  {
-    int i;
-    for (i=0; i < tp->max_running; i++) {
-      thread_pool_job_slot_type job_slot = tp->job_slots[i];
-      if (job_slot.run_count > 0)
-        pthread_join( job_slot.thread , NULL );
     }
   }
-  /* When we are here all the jobs have completed. */
   return NULL;
 }
 
@@ -306,9 +375,9 @@ static void * thread_pool_main_loop( void * arg ) {
 
 
 /**
-   This function initializes a couple of counters, and starts up the
-   dispatch thread. If the thread_pool should be reused after a join,
-   this function must be called before adding new jobs.
+   This function resets the job counters, and opens the pool for new
+   jobs. If the thread_pool should be reused after a join, this
+   function must be called before adding new jobs.
 
    The functions thread_pool_restart() and thread_pool_join() should
    be joined up like open/close and malloc/free combinations.
@@ -317,22 +386,11 @@ static void * thread_pool_main_loop( void * arg ) {
 void thread_pool_restart( thread_pool_type * tp ) {
   if (tp->accepting_jobs)
     util_abort("%s: fatal error - tried restart already running thread pool\n",__func__);
-  {
-    tp->join           = false;
-    tp->queue_index    = 0;
-    tp->queue_size     = 0;
-    {
-      int i;
-      for (i=0; i < tp->max_running; i++) {
-        tp->job_slots[i].run_count = 0;
-        tp->job_slots[i].running   = false;
-      }
-    }
 
-    /* Starting the dispatch thread. */
-    pthread_create( &tp->dispatch_thread , NULL , thread_pool_main_loop , tp );
-    tp->accepting_jobs = true;
-  }
+  pthread_mutex_lock( &tp->lock );
+  tp->queue_size     = 0;
+  tp->accepting_jobs = true;
+  pthread_mutex_unlock( &tp->lock );
 }
 
 
@@ -340,76 +398,93 @@ void thread_pool_restart( thread_pool_type * tp ) {
 /**
    This function is called by the calling scope when all the jobs have
    been submitted, and we just wait for them to complete.
-
-   This function just sets the join switch to true - this again tells
-   the dispatch_thread to start the join process on the worker
-   threads.
 */
 
 void thread_pool_join(thread_pool_type * pool) {
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
   if (pool->max_running > 0) {
-    pthread_join( pool->dispatch_thread , NULL );  /* Wait for the main thread to complete. */
+    if (current_worker != NULL && current_worker->pool == pool)
+      util_abort("%s: can not join the thread pool from one of its own jobs - use thread_pool_wait_job()\n",__func__);
+
+    pthread_mutex_lock( &pool->lock );
+    while (pool->pending > 0)
+      pthread_cond_wait( &pool->done_cond , &pool->lock );
     pool->accepting_jobs = false;
+    pthread_mutex_unlock( &pool->lock );
   }
 }
 
 /*
-  This will try to join the thread; if the manager thread has not
-  completed within @timeout_seconds the function will return false. If
-  the join fails the queue will be reset in a non-joining state and it
-  will be open for more jobs. Probably not in a 100% sane state.
+  This will try to join the pool; if the jobs have not completed
+  within @timeout_seconds the function will return false, and the
+  pool is left open for more jobs.
 */
 
 bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
   bool join_ok = true;
 
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
   if (pool->max_running > 0) {
     struct timespec ts;
-    time_t timeout_time = time( NULL );
-
-    util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
-    ts.tv_sec = timeout_time;
+    ts.tv_sec = time( NULL ) + timeout_seconds;
     ts.tv_nsec = 0;
 
-#ifdef HAVE_TIMEDJOIN
-
-    {
-      int join_return = pthread_timedjoin_np( pool->dispatch_thread , NULL , &ts);  /* Wait for the main thread to complete. */
-      if (join_return == 0)
-        pool->accepting_jobs = false;
-      else {
-        pool->join = false;
-        join_ok = false;
-      }
+    pthread_mutex_lock( &pool->lock );
+    while ((pool->pending > 0) && join_ok) {
+      if (pthread_cond_timedwait( &pool->done_cond , &pool->lock , &ts ) == ETIMEDOUT)
+        join_ok = (pool->pending == 0);
     }
+    if (join_ok)
+      pool->accepting_jobs = false;
+    pthread_mutex_unlock( &pool->lock );
+  }
+  return join_ok;
+}
 
-#else
 
-    while(true) {
-        if (pthread_kill(pool->dispatch_thread, 0) == 0){
-            util_yield();
-        } else {
-            pthread_join(pool->dispatch_thread, NULL);
-            pool->accepting_jobs = false;
-            break;
-        }
+/**
+   Will wait for the job with index @queue_index to complete, and
+   return the return value of the job. When called from a job running
+   in the pool the worker will run other jobs from the pool while
+   waiting, so that running jobs can wait for the jobs they have
+   added themselves.
+*/
 
-        time_t now = time(NULL);
+void * thread_pool_wait_job( thread_pool_type * pool , int queue_index ) {
+  thread_pool_worker_type * worker = NULL;
+  void * return_value;
+  if (current_worker != NULL && current_worker->pool == pool)
+    worker = current_worker;
 
-        if(util_difftime_seconds(now, timeout_time) <= 0) {
-            join_ok = false;
-            break;
-        }
-    }
+  if (worker != NULL) {
+    while (true) {
+      thread_pool_job_type job;
+      bool complete;
 
-#endif
+      pthread_mutex_lock( &pool->lock );
+      complete = pool->results[ queue_index ].complete;
+      pthread_mutex_unlock( &pool->lock );
+      if (complete)
+        break;
 
+      if (thread_pool_find_job( pool , worker , &job ))
+        thread_pool_run_job( pool , &job );
+      else {
+        pthread_mutex_lock( &pool->lock );
+        pool->helpers_waiting++;
+        while ((thread_pool_get_queued( pool ) <= 0) && !pool->results[ queue_index ].complete)
+          pthread_cond_wait( &pool->done_cond , &pool->lock );
+        pool->helpers_waiting--;
+        pthread_mutex_unlock( &pool->lock );
+      }
+    }
+  }
 
+  pthread_mutex_lock( &pool->lock );
+  while (!pool->results[ queue_index ].complete)
+    pthread_cond_wait( &pool->done_cond , &pool->lock );
+  return_value = pool->results[ queue_index ].return_value;
+  pthread_mutex_unlock( &pool->lock );
 
-  }
-  return join_ok;
+  return return_value;
 }
 
 
@@ -417,7 +492,7 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 
 /**
    max_running is the maximum number of concurrent threads. If
-   @start_queue is true the dispatch thread will start immediately. If
+   @start_queue is true the pool will accept jobs immediately. If
    the function is called with @start_queue == false you must first
    call thread_pool_restart() BEFORE you can start adding jobs.
 */
@@ -425,12 +500,32 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
   thread_pool_type * pool = util_malloc( sizeof *pool );
   UTIL_TYPE_ID_INIT( pool , THREAD_POOL_TYPE_ID );
-  pool->job_slots         = util_calloc( max_running , sizeof * pool->job_slots );
   pool->max_running       = max_running;
-  pool->queue             = NULL;
   pool->accepting_jobs    = false;
-  pthread_rwlock_init( &pool->queue_lock , NULL);
-  thread_pool_resize_queue( pool  , 32 );
+  pool->shutdown          = false;
+  pool->queued            = 0;
+  pool->pending           = 0;
+  pool->helpers_waiting   = 0;
+  pool->queue_size        = 0;
+  pool->queue_alloc_size  = 32;
+  pool->results           = util_calloc( pool->queue_alloc_size , sizeof * pool->results );
+  pthread_mutex_init( &pool->lock , NULL );
+  pthread_cond_init( &pool->work_cond , NULL );
+  pthread_cond_init( &pool->done_cond , NULL );
+  thread_pool_deque_init( &pool->submit_deque );
+
+  pool->workers = util_calloc( util_int_max( max_running , 1 ) , sizeof * pool->workers );
+  for (int i = 0; i < max_running; i++) {
+    thread_pool_worker_type * worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->worker_index = i;
+    thread_pool_deque_init( &worker->deque );
+  }
+
+  /* All the deques must be initialized before the workers start stealing from them. */
+  for (int i = 0; i < max_running; i++)
+    pthread_create( &pool->workers[i].thread , NULL , thread_pool_worker_main , &pool->workers[i] );
+
   if (start_queue)
     thread_pool_restart( pool );
   return pool;
@@ -438,48 +533,265 @@ thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
 
 
 
-void thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func , void * func_arg ) {
-  if (pool->max_running == 0) /* Blocking non-threaded mode: */
-    start_func( func_arg );
-  else {
+int thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func , void * func_arg ) {
+  int queue_index;
+  if (pool->max_running == 0) { /* Blocking non-threaded mode: */
+    queue_index = thread_pool_alloc_queue_index( pool );
+    pthread_mutex_lock( &pool->lock );
+    pool->pending++;
+    pthread_mutex_unlock( &pool->lock );
+    thread_pool_complete_job( pool , queue_index , start_func( func_arg ));
+  } else {
     if (pool->accepting_jobs) {
-      if (pool->queue_size == pool->queue_alloc_size)
-        thread_pool_resize_queue( pool , pool->queue_alloc_size * 2);
+      thread_pool_job_type job;
+
+      queue_index      = thread_pool_alloc_queue_index( pool );
+      job.func         = start_func;
+      job.func_arg     = func_arg;
+      job.queue_index  = queue_index;
+
+      pthread_mutex_lock( &pool->lock );
+      pool->pending++;
+      pthread_mutex_unlock( &pool->lock );
 
       /*
-         The new job is added to the queue - the main thread is watching
-         the queue and will pick up the new job.
+         Jobs added from a job running in this pool go to the deque of
+         the worker running it; other jobs go to the submit deque.
       */
-      {
-        int queue_index = pool->queue_size;
-
-        pool->queue[ queue_index ].pool         = pool;
-        pool->queue[ queue_index ].func_arg     = func_arg;
-        pool->queue[ queue_index ].func         = start_func;
-        pool->queue[ queue_index ].return_value = NULL;
-        pool->queue[ queue_index ].queue_index = queue_index;
-      }
-      pool->queue_size++;  /* <- This is shared between this thread and the dispatch thread */
-    } else
+      if (current_worker != NULL && current_worker->pool == pool)
+        thread_pool_deque_push( &current_worker->deque , &job );
+      else
+        thread_pool_deque_push( &pool->submit_deque , &job );
+
+      pthread_mutex_lock( &pool->lock );
+      __atomic_fetch_add( &pool->queued , 1 , __ATOMIC_SEQ_CST );
+      pthread_cond_signal( &pool->work_cond );
+      if (pool->helpers_waiting > 0)
+        pthread_cond_broadcast( &pool->done_cond );
+      pthread_mutex_unlock( &pool->lock );
+    } else {
       util_abort("%s: thread_pool is not running - restart with thread_pool_restart()?? \n",__func__);
+      queue_index = -1;
+    }
+  }
+  return queue_index;
+}
+
+
+/*****************************************************************/
+
+typedef struct {
+  thread_pool_range_ftype * body;
+  int                       begin;
+  int                       end;
+  void                    * arg;
+} thread_pool_range_type;
+
+
+static void * thread_pool_run_range( void * arg ) {
+  thread_pool_range_type * range = (thread_pool_range_type *) arg;
+  range->body( range->begin , range->end , range->arg );
+  return NULL;
+}
+
+
+/**
+   Will call body( chunk_begin , chunk_end , arg ) for chunks of
+   size @grain_size covering [begin,end), running the chunks as jobs in
+   the pool, and return when all the chunks have completed. With
+   grain_size <= 0 the range is split in roughly four chunks per
+   thread. Can be called both from outside the pool and from a job
+   running in the pool; the pool must be accepting jobs.
+*/
+
+void thread_pool_parallel_for( thread_pool_type * pool , int begin , int end , int grain_size , thread_pool_range_ftype * body , void * arg ) {
+  if (end <= begin)
+    return;
+
+  if (grain_size <= 0)
+    grain_size = util_int_max( 1 , (end - begin) / (4 * util_int_max( pool->max_running , 1 )));
+  {
+    int num_chunks = (end - begin + grain_size - 1) / grain_size;
+    thread_pool_range_type * ranges = util_calloc( num_chunks , sizeof * ranges );
+    int * queue_index = util_calloc( num_chunks , sizeof * queue_index );
+
+    for (int chunk = 0; chunk < num_chunks; chunk++) {
+      ranges[chunk].body  = body;
+      ranges[chunk].arg   = arg;
+      ranges[chunk].begin = begin + chunk * grain_size;
+      ranges[chunk].end   = util_int_min( end , ranges[chunk].begin + grain_size );
+      queue_index[chunk]  = thread_pool_add_job( pool , thread_pool_run_range , &ranges[chunk] );
+    }
+
+    for (int chunk = 0; chunk < num_chunks; chunk++)
+      thread_pool_wait_job( pool , queue_index[chunk] );
+
+    free( queue_index );
+    free( ranges );
   }
 }
 
 
 
 /*
-  Observe that this function does not join the worker threads,
-  i.e. you should call thread_pool_join() first (otherwise the thing
-  will go up in flames).
+  If the pool is still accepting jobs it is joined first, i.e. the
+  jobs which have been added will run to completion before the worker
+  threads are shut down.
 */
 
 
 void thread_pool_free(thread_pool_type * pool) {
-  util_safe_free( pool->job_slots );
-  util_safe_free( pool->queue );
+  if (pool->accepting_jobs)
+    thread_pool_join( pool );
+
+  pthread_mutex_lock( &pool->lock );
+  pool->shutdown = true;
+  pthread_cond_broadcast( &pool->work_cond );
+  pthread_mutex_unlock( &pool->lock );
+
+  for (int i = 0; i < pool->max_running; i++)
+    pthread_join( pool->workers[i].thread , NULL );
+
+  for (int i = 0; i < pool->max_running; i++)
+    thread_pool_deque_free( &pool->workers[i].deque );
+
+  thread_pool_deque_free( &pool->submit_deque );
+  pthread_cond_destroy( &pool->work_cond );
+  pthread_cond_destroy( &pool->done_cond );
+  pthread_mutex_destroy( &pool->lock );
+  free( pool->workers );
+  free( pool->results );
   free(pool);
 }
 
+/*****************************************************************/
+
+/*
+  The process wide cpu budget is the number of threads the various
+  thread pools in the code should use. The budget is determined as
+  follows:
+
+    1. If the environment variable ERT_MAX_THREADS is set to a
+       positive integer that value is used.
+    2. Otherwise, if a budget has been set with
+       thread_pool_set_cpu_budget() - typically from the MAX_THREADS
+       configuration key - that is used.
+    3. Otherwise the number of cpus available to the process is
+       used; that is the number of online cpus, limited by the cpu
+       affinity mask and a cgroup cpu quota - if any.
+*/
+
+#define CPU_BUDGET_ENV "ERT_MAX_THREADS"
+
+static int            cpu_budget = 0;
+static int            detected_cpu_count = 0;
+static pthread_once_t detect_cpu_once = PTHREAD_ONCE_INIT;
+
+
+static bool thread_pool_fscanf_quota( const char * filename , const char * fmt , long * value ) {
+  bool ok = false;
+  FILE * stream = fopen( filename , "r" );
+  if (stream != NULL) {
+    ok = (fscanf( stream , fmt , value ) == 1);
+    fclose( stream );
+  }
+  return ok;
+}
+
+
+/*
+  Returns the cpu limit implied by the cgroup cpu quota, rounded up,
+  or 0 if there is no quota. Both the unified (v2) and the v1
+  hierarchy are checked.
+*/
+
+static int thread_pool_get_cgroup_limit( void ) {
+  long quota  = -1;
+  long period = 0;
+  FILE * stream = fopen( "/sys/fs/cgroup/cpu.max" , "r" );
+  if (stream != NULL) {
+    if (fscanf( stream , "%ld %ld" , &quota , &period ) != 2)   /* An unlimited quota is written as "max". */
+      quota = -1;
+    fclose( stream );
+  } else {
+    if (thread_pool_fscanf_quota( "/sys/fs/cgroup/cpu/cpu.cfs_quota_us" , "%ld" , &quota ))
+      thread_pool_fscanf_quota( "/sys/fs/cgroup/cpu/cpu.cfs_period_us" , "%ld" , &period );
+  }
+
+  if ((quota > 0) && (period > 0))
+    return (int) ((quota + period - 1) / period);
+  else
+    return 0;
+}
+
+
+static void thread_pool_detect_cpu_count( void ) {
+  int num_cpu = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+  {
+    long online = sysconf( _SC_NPROCESSORS_ONLN );
+    if (online > 0)
+      num_cpu = online;
+  }
+#endif
+
+#ifdef HAVE_SCHED_GETAFFINITY
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO( &cpu_set );
+    if (sched_getaffinity( 0 , sizeof cpu_set , &cpu_set ) == 0) {
+      int affinity_count = CPU_COUNT( &cpu_set );
+      if (affinity_count > 0)
+        num_cpu = util_int_min( num_cpu , affinity_count );
+    }
+  }
+#endif
+
+  {
+    int cgroup_limit = thread_pool_get_cgroup_limit( );
+    if (cgroup_limit > 0)
+      num_cpu = util_int_min( num_cpu , cgroup_limit );
+  }
+
+  detected_cpu_count = num_cpu;
+}
+
+
+void thread_pool_set_cpu_budget( int num_cpu ) {
+  __atomic_store_n( &cpu_budget , util_int_max( 0 , num_cpu ) , __ATOMIC_SEQ_CST );
+}
+
+
+int thread_pool_get_cpu_budget( void ) {
+  {
+    const char * env_budget = getenv( CPU_BUDGET_ENV );
+    int num_cpu;
+    if (env_budget && util_sscanf_int( env_budget , &num_cpu ) && (num_cpu > 0))
+      return num_cpu;
+  }
+
+  {
+    int num_cpu = __atomic_load_n( &cpu_budget , __ATOMIC_SEQ_CST );
+    if (num_cpu > 0)
+      return num_cpu;
+  }
+
+  pthread_once( &detect_cpu_once , thread_pool_detect_cpu_count );
+  return detected_cpu_count;
+}
+
+
+/*
+  The number of threads to use for a pool which will run @num_jobs
+  independent jobs; i.e. the cpu budget, but never more threads than
+  there are jobs.
+*/
+
+int thread_pool_get_default_size( int num_jobs ) {
+  return util_int_max( 1 , util_int_min( thread_pool_get_cpu_budget( ) , num_jobs ));
+}
+
+
 int thread_pool_get_max_running( const thread_pool_type * pool ) {
   return pool->max_running;
 }
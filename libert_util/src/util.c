@@ -236,6 +236,52 @@ void util_endian_flip_vector(void *data, int element_size , int elements) {
   }
 }
 
+/**
+   Will copy @elements elements of size @element_size from @src to
+   @target and endian flip them in the same pass, i.e. the data is
+   only touched once. The @src and @target buffers can not overlap;
+   the simple loops below are written so that the compiler can
+   vectorize them.
+*/
+
+void util_endian_flip_copy(void * target , const void * src , int element_size , int elements) {
+  int i;
+  switch (element_size) {
+  case(1):
+    memcpy( target , src , elements );
+    break;
+  case(2):
+    {
+      uint16_t * target16 = (uint16_t *) target;
+      const uint16_t * src16 = (const uint16_t *) src;
+
+      for (i = 0; i < elements; i++)
+        target16[i] = util_endian_convert16(src16[i]);
+      break;
+    }
+  case(4):
+    {
+      uint32_t * target32 = (uint32_t *) target;
+      const uint32_t * src32 = (const uint32_t *) src;
+
+      for (i = 0; i < elements; i++)
+        target32[i] = util_endian_convert32(src32[i]);
+      break;
+    }
+  case(8):
+    {
+      uint64_t * target64 = (uint64_t *) target;
+      const uint64_t * src64 = (const uint64_t *) src;
+
+      for (i = 0; i < elements; i++)
+        target64[i] = util_endian_convert64(src64[i]);
+      break;
+    }
+  default:
+    util_abort("%s: can only endian flip 1/2/4/8 byte variables - aborting \n",__func__);
+  }
+}
+
 void util_endian_flip_vector_old(void *data, int element_size , int elements) {
   int i;
   switch (element_size) {
@@ -4602,6 +4648,47 @@ void util_fread(void *ptr , size_t element_size , size_t items, FILE * stream ,
 
 
 
+#ifdef ERT_HAVE_PREAD
+
+/**
+   Positioned read/write on a file descriptor; the file position of
+   fd is neither used nor updated, so several threads can read from
+   the same descriptor concurrently. Short reads/writes and EINTR are
+   retried; any other failure will abort.
+*/
+
+void util_pread(int fd , void * ptr , size_t byte_size , offset_type offset , const char * caller) {
+  char * data = ptr;
+  size_t total = 0;
+  while (total < byte_size) {
+    ssize_t bytes = pread( fd , &data[total] , byte_size - total , offset + total );
+    if (bytes > 0)
+      total += bytes;
+    else if ((bytes < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s/%s: only read %zu/%zu bytes from disk - aborting.\n %s(%d) \n",caller , __func__ , total , byte_size , strerror(errno) , errno);
+  }
+}
+
+
+void util_pwrite(int fd , const void * ptr , size_t byte_size , offset_type offset , const char * caller) {
+  const char * data = ptr;
+  size_t total = 0;
+  while (total < byte_size) {
+    ssize_t bytes = pwrite( fd , &data[total] , byte_size - total , offset + total );
+    if (bytes > 0)
+      total += bytes;
+    else if ((bytes < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s/%s: only wrote %zu/%zu bytes to disk - aborting: %s(%d) .\n",caller , __func__ , total , byte_size , strerror(errno) , errno);
+  }
+}
+
+#endif
+
+
 void util_fread_from_buffer(void * ptr , size_t element_size , size_t items , char ** buffer) {
   int bytes = element_size * items;
   memcpy( ptr , *buffer , bytes);
@@ -17,11 +17,14 @@
 */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 
 #include <ert/util/block_fs.h>
+#include <ert/util/buffer.h>
+#include <ert/util/thread_pool.h>
 #include <ert/util/test_util.h>
 #include <ert/util/test_work_area.h>
 
@@ -102,8 +105,140 @@ void test_lock_conflict() {
 
 
 
+#define NUM_FILES 100
+
+static void fill_data( int * data , int size , int value ) {
+  for (int i = 0; i < size; i++)
+    data[i] = value + i;
+}
+
+
+static void * read_files_mt( void * arg ) {
+  block_fs_type * bfs = block_fs_safe_cast( arg );
+  buffer_type * buffer = buffer_alloc( 100 );
+  int expected[NUM_FILES];
+
+  for (int iter = 0; iter < 10; iter++) {
+    for (int ifile = 0; ifile < NUM_FILES; ifile++) {
+      char * filename = util_alloc_sprintf("FILE_%d" , ifile);
+      int size = block_fs_get_filesize( bfs , filename ) / sizeof(int);
+
+      fill_data( expected , size , 1000 * ifile );
+      block_fs_fread_realloc_buffer( bfs , filename , buffer );
+      test_assert_int_equal( buffer_get_size( buffer ) , size * sizeof(int));
+      test_assert_int_equal( 0 , memcmp( buffer_get_data( buffer ) , expected , size * sizeof(int)));
+      free( filename );
+    }
+  }
+
+  buffer_free( buffer );
+  return NULL;
+}
+
+
+void test_concurrent_read( ) {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/concurrent_read");
+  block_fs_type * bfs = block_fs_mount( "test.mnt" , 1000 , 0 , 0.67 , 10 , false , false , false );
+  int data[NUM_FILES];
+
+  /* The second pass rewrites the files; some nodes are reused, and some will be reallocated. */
+  for (int pass = 0; pass < 2; pass++) {
+    for (int ifile = 0; ifile < NUM_FILES; ifile++) {
+      char * filename = util_alloc_sprintf("FILE_%d" , ifile);
+      int size = 1 + (ifile + pass * 37) % NUM_FILES;
+      fill_data( data , size , 1000 * ifile );
+      block_fs_fwrite_file( bfs , filename , data , size * sizeof(int));
+      free( filename );
+    }
+  }
+
+  {
+    thread_pool_type * tp = thread_pool_alloc( 8 , false );
+    thread_pool_restart( tp );
+    for (int i = 0; i < 8; i++)
+      thread_pool_add_job( tp , read_files_mt , bfs );
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+  }
+  block_fs_close( bfs , false );
+
+  bfs = block_fs_mount( "test.mnt" , 1000 , 0 , 0.67 , 10 , false , true , false );
+  read_files_mt( bfs );
+  block_fs_close( bfs , false );
+
+  test_work_area_free( work_area );
+}
+
+
+static void assert_file_content( block_fs_type * bfs , const char * filename , int size , int value) {
+  int expected[NUM_FILES];
+  int data[NUM_FILES];
+  fill_data( expected , size , value );
+  test_assert_int_equal( size * sizeof(int) , block_fs_get_filesize( bfs , filename ));
+  block_fs_fread_file( bfs , filename , data );
+  test_assert_int_equal( 0 , memcmp( data , expected , size * sizeof(int)));
+}
+
+
+void test_batch( ) {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/batch");
+  block_fs_type * bfs = block_fs_mount( "test.mnt" , 32 , 0 , 0.67 , 10 , false , false , false );
+  int data[NUM_FILES];
+
+  fill_data( data , 10 , 0 );
+  block_fs_fwrite_file( bfs , "OLD" , data , 10 * sizeof(int));
+  block_fs_fwrite_file( bfs , "REMOVED" , data , 10 * sizeof(int));
+
+  block_fs_begin_batch( bfs );
+  for (int ifile = 0; ifile < NUM_FILES; ifile++) {
+    char * filename = util_alloc_sprintf("FILE_%d" , ifile);
+    fill_data( data , ifile + 1 , ifile );
+    block_fs_fwrite_file( bfs , filename , data , (ifile + 1) * sizeof(int));
+    free( filename );
+  }
+
+  /* Nested batch; nothing is written until the outer batch is committed. */
+  block_fs_begin_batch( bfs );
+  fill_data( data , 50 , 77 );
+  block_fs_fwrite_file( bfs , "OLD" , data , 50 * sizeof(int));
+  block_fs_fwrite_file( bfs , "FILE_0" , data , 50 * sizeof(int));
+  block_fs_fwrite_file( bfs , "TMP" , data , 50 * sizeof(int));
+  block_fs_commit_batch( bfs );
+
+  block_fs_unlink_file( bfs , "TMP" );
+  block_fs_unlink_file( bfs , "REMOVED" );
+  test_assert_false( block_fs_has_file( bfs , "TMP" ));
+  test_assert_false( block_fs_has_file( bfs , "REMOVED" ));
+  test_assert_true( block_fs_has_file( bfs , "FILE_10" ));
+  assert_file_content( bfs , "OLD" , 50 , 77 );
+  assert_file_content( bfs , "FILE_0" , 50 , 77 );
+  block_fs_commit_batch( bfs );
+
+  for (int pass = 0; pass < 2; pass++) {
+    test_assert_false( block_fs_has_file( bfs , "TMP" ));
+    test_assert_false( block_fs_has_file( bfs , "REMOVED" ));
+    assert_file_content( bfs , "OLD" , 50 , 77 );
+    assert_file_content( bfs , "FILE_0" , 50 , 77 );
+    for (int ifile = 1; ifile < NUM_FILES; ifile++) {
+      char * filename = util_alloc_sprintf("FILE_%d" , ifile);
+      assert_file_content( bfs , filename , ifile + 1 , ifile );
+      free( filename );
+    }
+
+    /* The second pass checks that the data file is valid after remounting. */
+    block_fs_close( bfs , false );
+    bfs = block_fs_mount( "test.mnt" , 32 , 0 , 0.67 , 10 , false , pass == 0 , false );
+  }
+  block_fs_close( bfs , false );
+
+  test_work_area_free( work_area );
+}
+
+
 int main(int argc , char ** argv) {
   test_readonly();
   test_lock_conflict();
+  test_concurrent_read();
+  test_batch();
   exit(0);
 }
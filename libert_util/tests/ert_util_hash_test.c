@@ -19,10 +19,77 @@
 #include <stdbool.h>
 
 #include <ert/util/test_util.h>
+#include <ert/util/util.h>
 #include <ert/util/hash.h>
 
-int main(int argc , char ** argv) {
-  
+
+void test_insert_delete() {
+  hash_type * h = hash_alloc();
+  const int N = 10000;
+
+  for (int i = 0; i < N; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    hash_insert_int( h , key , i );
+    free( key );
+  }
+  test_assert_int_equal( N , hash_get_size( h ));
+
+  /* Delete every second key; the remaining keys must still be found through the deleted slots. */
+  for (int i = 0; i < N; i += 2) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    hash_del( h , key );
+    free( key );
+  }
+  test_assert_int_equal( N / 2 , hash_get_size( h ));
+
+  for (int i = 0; i < N; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    if (i % 2)
+      test_assert_int_equal( i , hash_get_int( h , key ));
+    else
+      test_assert_false( hash_has_key( h , key ));
+    free( key );
+  }
+
+  /* Reinserting - and replacing existing keys. */
+  for (int i = 0; i < N; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    hash_insert_int( h , key , -i );
+    free( key );
+  }
+  test_assert_int_equal( N , hash_get_size( h ));
+  test_assert_int_equal( -77 , hash_get_int( h , "KEY:77" ));
+  {
+    stringlist_type * keys = hash_alloc_stringlist( h );
+    test_assert_int_equal( N , stringlist_get_size( keys ));
+    stringlist_free( keys );
+  }
+
+  hash_clear( h );
+  test_assert_int_equal( 0 , hash_get_size( h ));
+  test_assert_false( hash_has_key( h , "KEY:77" ));
+  hash_insert_int( h , "KEY:77" , 77 );
+  test_assert_int_equal( 77 , hash_get_int( h , "KEY:77" ));
+  hash_free( h );
+}
+
+
+void test_freeze() {
+  hash_type * h = hash_alloc();
+  hash_insert_hash_owned_ref( h , "Key" , util_alloc_string_copy("Value") , free );
+  hash_resize( h , 1000 );
+  test_assert_false( hash_is_frozen( h ));
+
+  hash_freeze( h );
+  test_assert_true( hash_is_frozen( h ));
+  test_assert_string_equal( "Value" , hash_get( h , "Key" ));
+  test_assert_NULL( hash_safe_get( h , "NoSuchKey" ));
+  test_assert_int_equal( 1 , hash_get_size( h ));
+  hash_free( h );
+}
+
+
+void test_options() {
   hash_type * h = hash_alloc();
 
   test_assert_bool_equal( hash_add_option( h , "Key" ) , false );
@@ -39,5 +106,12 @@ int main(int argc , char ** argv) {
   test_assert_false( hash_has_key( h , "Key" ));
 
   hash_free( h );
+}
+
+
+int main(int argc , char ** argv) {
+  test_options();
+  test_insert_delete();
+  test_freeze();
   exit(0);
 }
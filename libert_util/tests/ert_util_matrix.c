@@ -228,6 +228,71 @@ void test_inplace_sub_column() {
 }
 
 
+/*
+  Compare the blocked matrix_inplace_matmul() with a naive triple
+  loop; the number of rows is deliberately not a multiple of the
+  block size.
+*/
+
+void test_inplace_matmul() {
+  const int rows = 1001;
+  const int N = 13;
+  rng_type * rng = rng_alloc(MZRAN , INIT_DEV_URANDOM );
+  matrix_type * A = matrix_alloc( rows , N );
+  matrix_type * B = matrix_alloc( N , N );
+  matrix_type * expected = matrix_alloc( rows , N );
+
+  matrix_random_init( A , rng );
+  matrix_random_init( B , rng );
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < N; j++) {
+      double sum = 0;
+      for (int k = 0; k < N; k++)
+        sum += matrix_iget( A , i , k ) * matrix_iget( B , k , j );
+      matrix_iset( expected , i , j , sum );
+    }
+
+  {
+    matrix_type * A1 = matrix_alloc_copy( A );
+    matrix_type * A2 = matrix_alloc_copy( A );
+
+    matrix_inplace_matmul( A1 , B );
+    matrix_inplace_matmul_mt1( A2 , B , 3 );
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < N; j++) {
+        test_assert_double_equal( matrix_iget( expected , i , j ) , matrix_iget( A1 , i , j ));
+        test_assert_double_equal( matrix_iget( expected , i , j ) , matrix_iget( A2 , i , j ));
+      }
+
+    matrix_free( A1 );
+    matrix_free( A2 );
+  }
+
+  /* A shared view where the column stride differs from the number of rows. */
+  {
+    matrix_type * A1 = matrix_alloc_copy( A );
+    matrix_type * view = matrix_alloc_shared( A1 , 100 , 0 , 500 , N );
+
+    matrix_inplace_matmul( view , B );
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < N; j++) {
+        if (i >= 100 && i < 600)
+          test_assert_double_equal( matrix_iget( expected , i , j ) , matrix_iget( A1 , i , j ));
+        else
+          test_assert_double_equal( matrix_iget( A , i , j ) , matrix_iget( A1 , i , j ));
+      }
+
+    matrix_free( view );
+    matrix_free( A1 );
+  }
+
+  matrix_free( expected );
+  matrix_free( B );
+  matrix_free( A );
+  rng_free( rng );
+}
+
+
 int main( int argc , char ** argv) {
   test_create_invalid();
   test_resize();
@@ -238,5 +303,6 @@ int main( int argc , char ** argv) {
   test_diag_std();
   test_masked_copy();
   test_inplace_sub_column();
+  test_inplace_matmul();
   exit(0);
 }
@@ -16,6 +16,7 @@
    for more details.
 */
 #include <stdlib.h>
+#include <stdint.h>
 #include <pthread.h>
 
 #include <ert/util/test_util.h>
@@ -60,11 +61,133 @@ void run() {
 }
 
 
+void * square(void * arg) {
+  intptr_t value = (intptr_t) arg;
+  return (void *) (value * value);
+}
+
+
+void test_return_value() {
+  thread_pool_type * tp = thread_pool_alloc( 4 , true );
+  for (intptr_t i = 0; i < 100; i++)
+    test_assert_int_equal( i , thread_pool_add_job( tp , square , (void *) i ));
+
+  test_assert_true( (intptr_t) thread_pool_wait_job( tp , 50 ) == 2500 );
+  thread_pool_join( tp );
+  for (intptr_t i = 0; i < 100; i++)
+    test_assert_true( (intptr_t) thread_pool_iget_return_value( tp , i ) == i * i );
+
+  /* Reusing the pool after a restart. */
+  thread_pool_restart( tp );
+  test_assert_int_equal( 0 , thread_pool_add_job( tp , square , (void *) 7 ));
+  thread_pool_join( tp );
+  test_assert_true( (intptr_t) thread_pool_iget_return_value( tp , 0 ) == 49 );
+  thread_pool_free( tp );
+}
+
+
+/*
+  Each job adds two child jobs until the depth is exhausted, and waits
+  for them; a pool with fewer threads than waiting jobs will deadlock
+  unless the waiting workers run the queued jobs.
+*/
+
+typedef struct {
+  thread_pool_type * tp;
+  int                depth;
+} tree_arg_type;
+
+
+void * count_tree(void * void_arg) {
+  tree_arg_type * arg = (tree_arg_type *) void_arg;
+  intptr_t count = 1;
+  if (arg->depth > 0) {
+    tree_arg_type child_arg = { .tp = arg->tp , .depth = arg->depth - 1 };
+    int left  = thread_pool_add_job( arg->tp , count_tree , &child_arg );
+    int right = thread_pool_add_job( arg->tp , count_tree , &child_arg );
+
+    count += (intptr_t) thread_pool_wait_job( arg->tp , left );
+    count += (intptr_t) thread_pool_wait_job( arg->tp , right );
+  }
+  return (void *) count;
+}
+
+
+void test_nested() {
+  thread_pool_type * tp = thread_pool_alloc( 2 , true );
+  tree_arg_type arg = { .tp = tp , .depth = 8 };
+  int root = thread_pool_add_job( tp , count_tree , &arg );
+
+  thread_pool_join( tp );
+  test_assert_true( (intptr_t) thread_pool_iget_return_value( tp , root ) == 511 );
+  thread_pool_free( tp );
+}
 
 
+void fill_range(int begin , int end , void * arg) {
+  int * data = (int *) arg;
+  for (int i = begin; i < end; i++)
+    data[i] += i;
+}
+
+
+void test_parallel_for() {
+  const int size = 10007;
+  int * data = calloc( size , sizeof * data );
+  thread_pool_type * tp = thread_pool_alloc( 4 , true );
+
+  thread_pool_parallel_for( tp , 0 , size , 0 , fill_range , data );
+  thread_pool_parallel_for( tp , 0 , size , 1000 , fill_range , data );
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+
+  for (int i = 0; i < size; i++)
+    test_assert_int_equal( 2 * i , data[i] );
+  free( data );
+}
+
+
+void test_blocking() {
+  int value = 0;
+  thread_pool_type * tp = thread_pool_alloc( 0 , true );
+
+  pthread_mutex_init(&lock , NULL);
+  thread_pool_add_job( tp , inc , &value );
+  test_assert_int_equal( 1 , value );
+  test_assert_true( (intptr_t) thread_pool_wait_job( tp , thread_pool_add_job( tp , square , (void *) 3 )) == 9 );
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+  pthread_mutex_destroy( &lock );
+}
+
+
+void test_cpu_budget() {
+  unsetenv( "ERT_MAX_THREADS" );
+  test_assert_true( thread_pool_get_cpu_budget( ) >= 1 );
+
+  thread_pool_set_cpu_budget( 3 );
+  test_assert_int_equal( 3 , thread_pool_get_cpu_budget( ));
+  test_assert_int_equal( 2 , thread_pool_get_default_size( 2 ));
+  test_assert_int_equal( 3 , thread_pool_get_default_size( 100 ));
+  test_assert_int_equal( 1 , thread_pool_get_default_size( 0 ));
+
+  setenv( "ERT_MAX_THREADS" , "5" , 1 );
+  test_assert_int_equal( 5 , thread_pool_get_cpu_budget( ));
+  setenv( "ERT_MAX_THREADS" , "not_an_int" , 1 );
+  test_assert_int_equal( 3 , thread_pool_get_cpu_budget( ));
+  unsetenv( "ERT_MAX_THREADS" );
+
+  thread_pool_set_cpu_budget( 0 );
+  test_assert_true( thread_pool_get_cpu_budget( ) >= 1 );
+}
 
 
 int main( int argc , char ** argv) {
   create_and_destroy();
   run();
+  test_return_value();
+  test_nested();
+  test_parallel_for();
+  test_blocking();
+  test_cpu_budget();
 }
@@ -24,8 +24,16 @@ extern "C" {
 #endif
 
 #include <ert/util/type_macros.h>
+#include <ert/util/int_vector.h>
 #include <ert/job_queue/queue_driver.h>
 
+/*
+  The statuses for which the status object keeps a list of the nodes
+  which have entered the status; these are the statuses where the
+  queue manager must act on the node.
+*/
+#define JOB_QUEUE_READY_STATUS (JOB_QUEUE_WAITING + JOB_QUEUE_SUBMITTED + JOB_QUEUE_DONE + JOB_QUEUE_EXIT + JOB_QUEUE_DO_KILL + JOB_QUEUE_DO_KILL_NODE_FAILURE)
+
   typedef struct job_queue_status_struct job_queue_status_type;
 
   job_queue_status_type * job_queue_status_alloc();
@@ -35,6 +43,11 @@ extern "C" {
   void job_queue_status_inc( job_queue_status_type * status_count , job_status_type status_type);
   bool job_queue_status_transition( job_queue_status_type * status_count , job_status_type src_status , job_status_type target_status);
   int job_queue_status_get_total_count( const job_queue_status_type * status );
+  void job_queue_status_add_ready( job_queue_status_type * status_count , int queue_index , job_status_type status_type);
+  void job_queue_status_fetch_ready( job_queue_status_type * status_count , job_status_type status_type , int_vector_type * index_list);
+  void job_queue_status_post_event( job_queue_status_type * status_count );
+  long job_queue_status_get_event_count( job_queue_status_type * status_count );
+  bool job_queue_status_wait_event( job_queue_status_type * status_count , long event_count , int timeout_usec);
 
   UTIL_IS_INSTANCE_HEADER( job_queue_status );
   UTIL_SAFE_CAST_HEADER( job_queue_status );
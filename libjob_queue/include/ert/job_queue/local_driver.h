@@ -43,6 +43,7 @@ extern "C" {
   job_status_type local_driver_get_job_status(void * __driver , void * __job);
   void            local_driver_free_job(void * __job);
   void            local_driver_init_option_list(stringlist_type * option_list);
+  void            local_driver_set_event_callback(void * __driver , queue_driver_event_ftype * callback , void * callback_arg);
 
 
 
@@ -106,6 +106,8 @@ extern "C" {
   typedef const void * (get_option_ftype) (const void *, const char *);
   typedef bool (has_option_ftype) (const void *, const char *);
   typedef void (init_option_list_ftype) (stringlist_type *);
+  typedef void (queue_driver_event_ftype) (void *);
+  typedef void (set_event_callback_ftype) (void *, queue_driver_event_ftype *, void *);
 
 
   queue_driver_type * queue_driver_alloc_RSH(const char * rsh_cmd, const hash_type * rsh_hostlist);
@@ -119,6 +121,7 @@ extern "C" {
   void queue_driver_blacklist_node(queue_driver_type * driver, void * job_data);
   void queue_driver_kill_job(queue_driver_type * driver, void * job_data);
   job_status_type queue_driver_get_status(queue_driver_type * driver, void * job_data);
+  bool queue_driver_set_event_callback(queue_driver_type * driver, queue_driver_event_ftype * callback, void * callback_arg);
 
   const char * queue_driver_get_name(const queue_driver_type * driver);
 
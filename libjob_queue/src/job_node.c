@@ -442,6 +442,23 @@ static void job_queue_node_set_status(job_queue_node_type * node , job_status_ty
 }
 
 
+/*
+  Updates the status counters and the status of the node, and - when
+  the status has changed - registers the node in the ready list of the
+  new status. The node must be locked.
+*/
+
+static bool job_queue_node_change_status__( job_queue_node_type * node , job_queue_status_type * status , job_status_type new_status) {
+  job_status_type old_status = job_queue_node_get_status( node );
+  bool status_change = job_queue_status_transition( status , old_status , new_status );
+  if (status_change) {
+    job_queue_node_set_status( node , new_status );
+    job_queue_status_add_ready( status , node->queue_index , new_status );
+  }
+  return status_change;
+}
+
+
 submit_status_type job_queue_node_submit( job_queue_node_type * node , job_queue_status_type * status , queue_driver_type * driver) {
   submit_status_type submit_status;
   pthread_mutex_lock( &node->data_mutex );
@@ -454,9 +471,6 @@ submit_status_type job_queue_node_submit( job_queue_node_type * node , job_queue
                                                node->argc,
                                                (const char **) node->argv);
     if (job_data != NULL) {
-      job_status_type old_status = node->job_status;
-      job_status_type new_status = JOB_QUEUE_SUBMITTED;
-
       node->job_data = job_data;
       node->submit_attempt++;
       /*
@@ -468,8 +482,7 @@ submit_status_type job_queue_node_submit( job_queue_node_type * node , job_queue
         job_queue_node free function must be called on it.
       */
       submit_status = SUBMIT_OK;
-      job_queue_node_set_status( node , new_status);
-      job_queue_status_transition(status, old_status, new_status);
+      job_queue_node_change_status__( node , status , JOB_QUEUE_SUBMITTED );
     } else
       /*
         In this case the status of the job itself will be
@@ -513,16 +526,13 @@ bool job_queue_node_update_status( job_queue_node_type * node , job_queue_status
         double runtime = job_queue_node_time_since_sim_start(node);
         if (runtime >= node->max_confirm_wait) {
           // max_confirm_wait has passed since sim_start without success; the job is dead
-          job_status_type new_status = JOB_QUEUE_DO_KILL_NODE_FAILURE;
-          status_change = job_queue_status_transition(status, current_status, new_status);
-          job_queue_node_set_status(node, new_status);
+          status_change = job_queue_node_change_status__( node , status , JOB_QUEUE_DO_KILL_NODE_FAILURE );
         }
       }
       current_status = job_queue_node_get_status(node);
       if (current_status & JOB_QUEUE_CAN_UPDATE_STATUS) {
         job_status_type new_status = queue_driver_get_status( driver , node->job_data);
-        status_change = job_queue_status_transition(status , current_status , new_status);
-        job_queue_node_set_status(node,new_status);
+        status_change = job_queue_node_change_status__( node , status , new_status );
       }
     }
   }
@@ -534,11 +544,7 @@ bool job_queue_node_status_transition( job_queue_node_type * node , job_queue_st
   bool status_change;
   pthread_mutex_lock( &node->data_mutex );
   {
-    job_status_type old_status = job_queue_node_get_status( node );
-    status_change = job_queue_status_transition(status , old_status, new_status);
-
-    if (status_change)
-      job_queue_node_set_status( node , new_status );
+    status_change = job_queue_node_change_status__( node , status , new_status );
   }
   pthread_mutex_unlock( &node->data_mutex );
   return status_change;
@@ -570,8 +576,7 @@ bool job_queue_node_kill( job_queue_node_type * node , job_queue_status_type * s
         queue_driver_free_job( driver , node->job_data );
         node->job_data = NULL;
       }
-      job_queue_status_transition(status, current_status, JOB_QUEUE_IS_KILLED);
-      job_queue_node_set_status( node , JOB_QUEUE_IS_KILLED);
+      job_queue_node_change_status__( node , status , JOB_QUEUE_IS_KILLED );
       result = true;
     }
   }
@@ -617,9 +622,7 @@ void * job_queue_node_get_driver_data( job_queue_node_type * node ) {
 void job_queue_node_restart( job_queue_node_type * node , job_queue_status_type * status) {
   pthread_mutex_lock( &node->data_mutex );
   {
-    job_status_type current_status = job_queue_node_get_status( node );
-    job_queue_status_transition(status, current_status, JOB_QUEUE_WAITING);
-    job_queue_node_set_status( node , JOB_QUEUE_WAITING);
+    job_queue_node_change_status__( node , status , JOB_QUEUE_WAITING );
     job_queue_node_reset_submit_attempt(node);
   }
   pthread_mutex_unlock( &node->data_mutex );
@@ -23,9 +23,12 @@
 #include <stdio.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <sys/time.h>
 
 #include <ert/util/msg.h>
 #include <ert/util/util.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/bool_vector.h>
 #include <ert/util/thread_pool.h>
 #include <ert/util/arg_pack.h>
 
@@ -228,9 +231,20 @@ struct job_queue_struct {
   int                        max_ok_wait_time;                  /* Seconds to wait for an OK file - when the job itself has said all OK. */
   int                        max_duration;                      /* Maximum allowed time for a job to run, 0 = unlimited */
   time_t                     stop_time;                         /* A job is only allowed to run until this time. 0 = no time set, ignore stop_time */
-  unsigned long              usleep_time;                       /* The sleep time before checking for updates. */
+  unsigned long              usleep_time;                       /* The sleep time before polling the driver for status updates. */
+  unsigned long              event_usleep_time;                 /* The sleep time between polls when the driver reports status changes itself. */
+  double                     submit_rate;                       /* The max number of jobs submitted per second; 0 means no limit. */
+  double                     submit_tokens;                     /* The number of submits currently available - refilled at submit_rate. */
+  double                     submit_refill_time;
   pthread_mutex_t            run_mutex;                         /* This mutex is used to ensure that ONLY one thread is executing the job_queue_run_jobs(). */
   thread_pool_type         * work_pool;
+
+  /* The fields below are only used by the thread running job_queue_run_jobs(). */
+  int_vector_type          * waiting_list;                      /* Queue indices of WAITING nodes in submit order - can contain stale entries. */
+  int                        waiting_offset;                    /* The first element in waiting_list which has not been handled. */
+  int_vector_type          * active_list;                       /* Queue indices of the nodes which have been submitted to the driver. */
+  bool_vector_type         * active_mask;
+  int_vector_type          * ready_list;
 };
 
 
@@ -272,18 +286,42 @@ static bool job_queue_change_node_status(job_queue_type * queue , job_queue_node
 
 /*
   Will return true if there is any status change. Must already hold
-  on to joblist readlock
+  on to joblist readlock.
+
+  Only the nodes in the active_list, i.e. the nodes which have been
+  submitted to the driver, are polled. New entries are picked up from
+  the SUBMITTED ready list, and nodes which have left the
+  JOB_QUEUE_CAN_UPDATE_STATUS states are removed from the list.
 */
 
 static bool job_queue_update_status(job_queue_type * queue ) {
   bool update = false;
-  int ijob;
 
-  for (ijob = 0; ijob < job_list_get_size( queue->job_list ); ijob++) {
-    job_queue_node_type * node = job_list_iget_job( queue->job_list , ijob );
-    bool node_update = job_queue_node_update_status( node , queue->status , queue->driver );
-    if (node_update)
-      update = true;
+  int_vector_reset( queue->ready_list );
+  job_queue_status_fetch_ready( queue->status , JOB_QUEUE_SUBMITTED , queue->ready_list );
+  for (int i = 0; i < int_vector_size( queue->ready_list ); i++) {
+    int queue_index = int_vector_iget( queue->ready_list , i );
+    if (!bool_vector_safe_iget( queue->active_mask , queue_index )) {
+      bool_vector_iset( queue->active_mask , queue_index , true );
+      int_vector_append( queue->active_list , queue_index );
+    }
+  }
+
+  {
+    int num_active = 0;
+    for (int i = 0; i < int_vector_size( queue->active_list ); i++) {
+      int queue_index = int_vector_iget( queue->active_list , i );
+      job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
+      bool node_update = job_queue_node_update_status( node , queue->status , queue->driver );
+      if (node_update)
+        update = true;
+
+      if (job_queue_node_get_status( node ) & JOB_QUEUE_CAN_UPDATE_STATUS)
+        int_vector_iset( queue->active_list , num_active++ , queue_index );
+      else
+        bool_vector_iset( queue->active_mask , queue_index , false );
+    }
+    int_vector_resize( queue->active_list , num_active );
   }
   return update;
 }
@@ -810,12 +848,149 @@ static void job_queue_handle_EXIT( job_queue_type * queue , job_queue_node_type
 
 /*****************************************************************/
 
+static double job_queue_get_time( void ) {
+  struct timeval now;
+  gettimeofday( &now , NULL );
+  return now.tv_sec + 1e-6 * now.tv_usec;
+}
+
+
+/*
+  The submit rate is enforced with a token bucket: tokens are refilled
+  at a rate of submit_rate per second, up to one second's worth of
+  tokens, and each submit consumes one token.
+*/
+
+static void job_queue_refill_submit_tokens( job_queue_type * queue ) {
+  double now = job_queue_get_time( );
+  if (queue->submit_rate > 0) {
+    double capacity = util_double_max( 1.0 , queue->submit_rate );
+    queue->submit_tokens += (now - queue->submit_refill_time) * queue->submit_rate;
+    if (queue->submit_tokens > capacity)
+      queue->submit_tokens = capacity;
+  }
+  queue->submit_refill_time = now;
+}
+
+
+/*
+  Returns the number of microseconds until the next submit token is
+  available, or 0 if a token is available.
+*/
+
+static int job_queue_get_submit_wait( const job_queue_type * queue ) {
+  if ((queue->submit_rate <= 0) || (queue->submit_tokens >= 1))
+    return 0;
+  else
+    return 1 + (int) (1e6 * (1 - queue->submit_tokens) / queue->submit_rate);
+}
+
+
+/*
+  Will submit WAITING jobs, in the order they entered the WAITING
+  status, until either max_running is reached, the submit rate limit
+  is reached or the driver refuses to take more jobs. Returns the
+  number of jobs submitted. Must hold on to the joblist readlock.
+*/
+
+static int job_queue_submit_waiting( job_queue_type * queue ) {
+  int submit_count = 0;
+  int num_submit_new;
+
+  job_queue_status_fetch_ready( queue->status , JOB_QUEUE_WAITING , queue->waiting_list );
+  {
+    int total_active = job_queue_status_get_count(queue->status, JOB_QUEUE_PENDING) +
+                       job_queue_status_get_count(queue->status, JOB_QUEUE_RUNNING) +
+                       job_queue_status_get_count(queue->status, JOB_QUEUE_SUBMITTED);
+    int max_running  = job_queue_get_max_running( queue );
+    if (max_running > 0)
+      num_submit_new = max_running - total_active;
+    else
+      /*
+         If max_running == 0 that should be interpreted as no limit; i.e. the queue layer will
+         attempt to send an unlimited number of jobs to the driver - the driver can reject the jobs.
+      */
+      num_submit_new = job_queue_status_get_count(queue->status, JOB_QUEUE_WAITING);
+  }
+
+  job_queue_refill_submit_tokens( queue );
+  while ((queue->waiting_offset < int_vector_size( queue->waiting_list )) && (num_submit_new > 0)) {
+    int queue_index = int_vector_iget( queue->waiting_list , queue->waiting_offset );
+    job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
+
+    if (job_queue_node_get_status(node) == JOB_QUEUE_WAITING) {
+      submit_status_type submit_status;
+
+      if ((queue->submit_rate > 0) && (queue->submit_tokens < 1))
+        break;
+
+      submit_status = job_queue_submit_job(queue , queue_index);
+      if (submit_status == SUBMIT_OK) {
+        num_submit_new--;
+        submit_count++;
+        if (queue->submit_rate > 0)
+          queue->submit_tokens -= 1;
+      } else if ((submit_status == SUBMIT_DRIVER_FAIL) || (submit_status == SUBMIT_QUEUE_CLOSED))
+        break;   /* The node stays at the head of the waiting list. */
+    }
+    queue->waiting_offset++;
+  }
+
+  if ((queue->waiting_offset > 0) && (2 * queue->waiting_offset >= int_vector_size( queue->waiting_list ))) {
+    int_vector_idel_block( queue->waiting_list , 0 , queue->waiting_offset );
+    queue->waiting_offset = 0;
+  }
+  return submit_count;
+}
+
+
+/*
+  Will handle the nodes which have entered the status @status since
+  the last call; @status should be one of DONE, EXIT,
+  DO_KILL_NODE_FAILURE and DO_KILL. The ready list can contain stale
+  entries, so the current status of each node is checked first. Must
+  hold on to the joblist readlock.
+*/
+
+static void job_queue_handle_ready( job_queue_type * queue , job_status_type status) {
+  int_vector_reset( queue->ready_list );
+  job_queue_status_fetch_ready( queue->status , status , queue->ready_list );
+  for (int i = 0; i < int_vector_size( queue->ready_list ); i++) {
+    job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( queue->ready_list , i ));
+    if (job_queue_node_get_status(node) == status) {
+      switch (status) {
+        case(JOB_QUEUE_DONE):
+          job_queue_handle_DONE(queue, node);
+          break;
+        case(JOB_QUEUE_EXIT):
+          job_queue_handle_EXIT(queue, node);
+          break;
+        case(JOB_QUEUE_DO_KILL_NODE_FAILURE):
+          job_queue_handle_DO_KILL_NODE_FAILURE(queue, node);
+          break;
+        case(JOB_QUEUE_DO_KILL):
+          job_queue_handle_DO_KILL(queue, node);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+
+static void job_queue_driver_event__( void * arg ) {
+  job_queue_type * queue = (job_queue_type *) arg;
+  job_queue_status_post_event( queue->status );
+}
+
+
 static void job_queue_check_expired(job_queue_type * queue) {
   if ((job_queue_get_max_job_duration(queue) <= 0) && (job_queue_get_job_stop_time(queue) <= 0))
     return;
 
-  for (int i = 0; i < job_list_get_size( queue->job_list ); i++) {
-    job_queue_node_type * node = job_list_iget_job( queue->job_list , i );
+  for (int i = 0; i < int_vector_size( queue->active_list ); i++) {
+    job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( queue->active_list , i ));
 
     if (job_queue_node_get_status(node) == JOB_QUEUE_RUNNING) {
       time_t now = time(NULL);
@@ -879,19 +1054,36 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
 
     /*
       The number of threads in the thread pool running callbacks. Memory consumption can
-      potentially be quite high while running the DONE callback - should therefor not use
-      too many threads.
+      potentially be quite high while running the DONE callback - the process wide cpu
+      budget can be lowered with the MAX_THREADS / ERT_MAX_THREADS settings.
     */
-    const int NUM_WORKER_THREADS = 4;
-    queue->work_pool = thread_pool_alloc( NUM_WORKER_THREADS , true );
+    const int num_worker_threads = thread_pool_get_cpu_budget( );
+    queue->work_pool = thread_pool_alloc( num_worker_threads , true );
     {
       bool new_jobs         = false;
       bool cont             = true;
       int  phase = 0;
+      /*
+        When the driver reports status changes by itself the driver is
+        polled less frequently; the polling is then only needed for the
+        max_duration / stop_time checks and the status file checks.
+      */
+      bool driver_events    = queue_driver_set_event_callback( queue->driver , job_queue_driver_event__ , queue );
+      int  poll_usleep      = driver_events ? queue->event_usleep_time : queue->usleep_time;
+
+      int_vector_reset( queue->waiting_list );
+      int_vector_reset( queue->active_list );
+      bool_vector_reset( queue->active_mask );
+      queue->waiting_offset = 0;
+      queue->submit_tokens = util_double_max( 1.0 , queue->submit_rate );
+      queue->submit_refill_time = job_queue_get_time( );
 
       queue->running = true;
       do {
         bool local_user_exit = false;
+        int  wait_usleep     = poll_usleep;
+        long event_count     = job_queue_status_get_event_count( queue->status );
+
         job_list_get_rdlock( queue->job_list );
         /*****************************************************************/
         if (queue->user_exit)  {/* An external thread has called the job_queue_user_exit() function, and we should kill
@@ -901,11 +1093,10 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
           local_user_exit = true;
         }
 
-        job_queue_check_expired(queue);
-
         /*****************************************************************/
         {
           bool update_status = job_queue_update_status( queue );
+          job_queue_check_expired(queue);
           if (verbose) {
             if (update_status || new_jobs)
               job_queue_print_summary(queue , update_status );
@@ -943,78 +1134,23 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
 
           if (cont) {
             /* Submitting new jobs */
-            int max_submit     = 5; /* This is the maximum number of jobs submitted in one while() { ... } below.
-                                       Only to ensure that the waiting time before a status update is not too long. */
-            int total_active   = job_queue_status_get_count(queue->status, JOB_QUEUE_PENDING) + job_queue_status_get_count(queue->status, JOB_QUEUE_RUNNING);
-            int num_submit_new;
-
-            {
-              int max_running = job_queue_get_max_running( queue );
-              if (max_running > 0)
-                num_submit_new = util_int_min( max_submit ,  max_running - total_active );
-              else
-                /*
-                   If max_running == 0 that should be interpreted as no limit; i.e. the queue layer will
-                   attempt to send an unlimited number of jobs to the driver - the driver can reject the jobs.
-                */
-                num_submit_new = util_int_min( max_submit , job_queue_status_get_count(queue->status, JOB_QUEUE_WAITING));
+            new_jobs = (job_queue_submit_waiting( queue ) > 0);
+
+            /*
+              If jobs are held back by the submit rate limit we wake up
+              when the next submit is allowed.
+            */
+            if (queue->waiting_offset < int_vector_size( queue->waiting_list )) {
+              int submit_wait = job_queue_get_submit_wait( queue );
+              if (submit_wait > 0)
+                wait_usleep = util_int_min( wait_usleep , submit_wait );
             }
 
-            new_jobs = false;
-            if (job_queue_status_get_count(queue->status, JOB_QUEUE_WAITING) > 0)   /* We have waiting jobs at all           */
-              if (num_submit_new > 0)                                               /* The queue can allow more running jobs */
-                new_jobs = true;
-
-            if (new_jobs) {
-              int submit_count = 0;
-              int queue_index  = 0;
-
-              while ((queue_index < job_list_get_size( queue->job_list )) && (num_submit_new > 0)) {
-                job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
-                if (job_queue_node_get_status(node) == JOB_QUEUE_WAITING) {
-                  {
-                    submit_status_type submit_status = job_queue_submit_job(queue , queue_index);
-
-                    if (submit_status == SUBMIT_OK) {
-                      num_submit_new--;
-                      submit_count++;
-                    } else if ((submit_status == SUBMIT_DRIVER_FAIL) || (submit_status == SUBMIT_QUEUE_CLOSED))
-                      break;
-                  }
-                }
-                queue_index++;
-              }
-            }
-
-
-            {
-              /*
-                Checking for complete / exited / overtime jobs
-               */
-              int queue_index;
-              for (queue_index = 0; queue_index < job_list_get_size( queue->job_list ); queue_index++) {
-                job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
-
-                switch (job_queue_node_get_status(node)) {
-                  case(JOB_QUEUE_DONE):
-                    job_queue_handle_DONE(queue, node);
-                    break;
-                  case(JOB_QUEUE_EXIT):
-                    job_queue_handle_EXIT(queue, node);
-                    break;
-                  case(JOB_QUEUE_DO_KILL_NODE_FAILURE):
-                    job_queue_handle_DO_KILL_NODE_FAILURE(queue, node);
-                    break;
-                  case(JOB_QUEUE_DO_KILL):
-                    job_queue_handle_DO_KILL(queue, node);
-                    break;
-                  default:
-                    break;
-                }
-
-
-              }
-            }
+            /* Handling complete / exited / overtime jobs */
+            job_queue_handle_ready( queue , JOB_QUEUE_DONE );
+            job_queue_handle_ready( queue , JOB_QUEUE_EXIT );
+            job_queue_handle_ready( queue , JOB_QUEUE_DO_KILL_NODE_FAILURE );
+            job_queue_handle_ready( queue , JOB_QUEUE_DO_KILL );
           } else
             /* print an updated status to stdout before exiting. */
             if (verbose)
@@ -1023,11 +1159,14 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
         job_list_unlock( queue->job_list );
         if (local_user_exit)
           cont = false;    /* This is how we signal that we want to get out . */
-        else {
-          util_yield();
-          job_list_reader_wait( queue->job_list , queue->usleep_time , 8 * queue->usleep_time);
-        }
+        else if (cont)
+          /*
+            Sleep until there is a status change - from the driver, the
+            callbacks or the calling scope - or the poll time expires.
+          */
+          job_queue_status_wait_event( queue->status , event_count , wait_usleep );
       } while ( cont );
+      queue_driver_set_event_callback( queue->driver , NULL , NULL );
     }
     if (verbose)
       printf("\n");
@@ -1186,6 +1325,10 @@ job_queue_type * job_queue_alloc(int  max_submit               ,
   job_queue_type * queue  = util_malloc(sizeof * queue );
   UTIL_TYPE_ID_INIT( queue , JOB_QUEUE_TYPE_ID);
   queue->usleep_time      = 250000; /* 1000000 : 1 second */
+  queue->event_usleep_time = 1000000;
+  queue->submit_rate      = 0;
+  queue->submit_tokens    = 0;
+  queue->submit_refill_time = 0;
   queue->max_ok_wait_time = 60;
   queue->max_duration     = 0;
   queue->stop_time        = 0;
@@ -1202,6 +1345,11 @@ job_queue_type * job_queue_alloc(int  max_submit               ,
   queue->work_pool        = NULL;
   queue->job_list         = job_list_alloc(  );
   queue->status           = job_queue_status_alloc( );
+  queue->waiting_list     = int_vector_alloc( 0 , 0 );
+  queue->waiting_offset   = 0;
+  queue->active_list      = int_vector_alloc( 0 , 0 );
+  queue->active_mask      = bool_vector_alloc( 0 , false );
+  queue->ready_list       = int_vector_alloc( 0 , 0 );
 
   pthread_mutex_init( &queue->run_mutex    , NULL );
 
@@ -1219,6 +1367,23 @@ job_queue_type * job_queue_alloc(int  max_submit               ,
 
 void job_queue_submit_complete( job_queue_type * queue ){
   queue->submit_complete = true;
+  job_queue_status_post_event( queue->status );
+}
+
+
+/**
+   Limits the number of jobs submitted to the driver to @submit_rate
+   jobs per second; with the default value 0 there is no limit, and
+   the number of submitted jobs is only limited by max_running.
+*/
+
+void job_queue_set_submit_rate( job_queue_type * queue , double submit_rate ) {
+  queue->submit_rate = util_double_max( 0 , submit_rate );
+}
+
+
+double job_queue_get_submit_rate( const job_queue_type * queue ) {
+  return queue->submit_rate;
 }
 
 
@@ -1270,6 +1435,7 @@ void job_queue_set_pause_on( job_queue_type * job_queue) {
 
 void job_queue_set_pause_off( job_queue_type * job_queue) {
   job_queue->pause_on = false;
+  job_queue_status_post_event( job_queue->status );
 }
 
 /*
@@ -1290,6 +1456,7 @@ bool job_queue_start_user_exit( job_queue_type * queue) {
     while (true) {
       if (queue->running) {
         queue->user_exit = true;
+        job_queue_status_post_event( queue->status );
         break;
     }
       usleep( usleep_time );
@@ -1311,6 +1478,10 @@ void job_queue_free(job_queue_type * queue) {
   util_safe_free( queue->exit_file );
   job_list_free( queue->job_list );
   job_queue_status_free( queue->status );
+  int_vector_free( queue->waiting_list );
+  int_vector_free( queue->active_list );
+  bool_vector_free( queue->active_mask );
+  int_vector_free( queue->ready_list );
   free(queue);
 }
 
@@ -16,20 +16,40 @@
    for more details.
 */
 #include <pthread.h>
+#include <errno.h>
+#include <sys/time.h>
 
 #include <ert/util/type_macros.h>
 #include <ert/util/util.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/job_queue/queue_driver.h>
 #include <ert/job_queue/job_queue_status.h>
 
 #define JOB_QUEUE_STATUS_TYPE_ID 777620306
 
+/*
+  In addition to the counters the status object keeps, for each of
+  the statuses in JOB_QUEUE_READY_STATUS, a list of the queue indices
+  of the nodes which have entered that status. The lists are drained
+  by the queue manager with job_queue_status_fetch_ready(); since a
+  node can leave the status again before the manager gets to it the
+  lists can contain stale entries, and the manager must check the
+  status of the node before acting on it.
+
+  Every status transition, and every call to
+  job_queue_status_post_event(), increments the event counter and
+  wakes up threads waiting in job_queue_status_wait_event().
+*/
+
 struct job_queue_status_struct {
   UTIL_TYPE_ID_DECLARATION;
   int status_list[JOB_QUEUE_MAX_STATE];
   pthread_mutex_t update_mutex;
+  pthread_cond_t  event_cond;
+  long            event_count;
   int status_index[JOB_QUEUE_MAX_STATE];
+  int_vector_type * ready_list[JOB_QUEUE_MAX_STATE];
 };
 
 
@@ -57,10 +77,8 @@ job_queue_status_type * job_queue_status_alloc() {
   job_queue_status_type * status = util_malloc( sizeof * status );
   UTIL_TYPE_ID_INIT( status ,   JOB_QUEUE_STATUS_TYPE_ID );
   pthread_mutex_init( &status->update_mutex , NULL );
-  job_queue_status_clear( status );
-
-    
- 
+  pthread_cond_init( &status->event_cond , NULL );
+  status->event_count = 0;
 
     status->status_index[0] = JOB_QUEUE_NOT_ACTIVE; // Initial, allocated job state, job not added - controlled by job_queue
     status->status_index[1] = JOB_QUEUE_WAITING; // The job is ready to be started - controlled by job_queue
@@ -76,23 +94,39 @@ job_queue_status_type * job_queue_status_alloc() {
     status->status_index[11] = JOB_QUEUE_FAILED; // Job has failed, no more retries, FINAL STATE
     status->status_index[12] = JOB_QUEUE_DO_KILL_NODE_FAILURE; // Job has failed, node should be blacklisted
     status->status_index[13] = JOB_QUEUE_STATUS_FAILURE; //The driver call to get status has failed, job status remains unchanged
-    
-    
-    
-    
+
+    for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++) {
+      if (status->status_index[index] & JOB_QUEUE_READY_STATUS)
+        status->ready_list[index] = int_vector_alloc( 0 , 0 );
+      else
+        status->ready_list[index] = NULL;
+    }
+    job_queue_status_clear( status );
+
   return status;
 }
 
 
 void job_queue_status_free( job_queue_status_type * status ) {
+  for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++) {
+    if (status->ready_list[index])
+      int_vector_free( status->ready_list[index] );
+  }
+  pthread_cond_destroy( &status->event_cond );
+  pthread_mutex_destroy( &status->update_mutex );
   free( status );
 }
 
 
 void job_queue_status_clear( job_queue_status_type * status ) {
   int index;
-  for (index = 0; index < JOB_QUEUE_MAX_STATE; index++)
+  pthread_mutex_lock( &status->update_mutex );
+  for (index = 0; index < JOB_QUEUE_MAX_STATE; index++) {
     status->status_list[ index ] = 0;
+    if (status->ready_list[ index ])
+      int_vector_reset( status->ready_list[ index ] );
+  }
+  pthread_mutex_unlock( &status->update_mutex );
 }
 
 
@@ -149,10 +183,96 @@ bool job_queue_status_transition(job_queue_status_type * status_count, job_statu
 
   job_queue_status_dec( status_count, src_status );
   job_queue_status_inc( status_count, target_status );
+  job_queue_status_post_event( status_count );
   return true;
 }
 
 
+/*
+  Registers that the node with index @queue_index has entered status
+  @status_type; should be called after the status of the node has been
+  updated. Only the JOB_QUEUE_READY_STATUS statuses are registered.
+*/
+
+void job_queue_status_add_ready( job_queue_status_type * status_count , int queue_index , job_status_type status_type) {
+  if (status_type & JOB_QUEUE_READY_STATUS) {
+    int index = STATUS_INDEX( status_count , status_type );
+    pthread_mutex_lock( &status_count->update_mutex );
+    int_vector_append( status_count->ready_list[index] , queue_index );
+    status_count->event_count++;
+    pthread_cond_broadcast( &status_count->event_cond );
+    pthread_mutex_unlock( &status_count->update_mutex );
+  }
+}
+
+
+/*
+  Will append the content of the ready list for status @status_type
+  to @index_list, and clear the ready list.
+*/
+
+void job_queue_status_fetch_ready( job_queue_status_type * status_count , job_status_type status_type , int_vector_type * index_list) {
+  int index = STATUS_INDEX( status_count , status_type );
+  if (status_count->ready_list[index] == NULL)
+    util_abort("%s: no ready list is maintained for status:%d \n",__func__ , status_type);
+
+  pthread_mutex_lock( &status_count->update_mutex );
+  {
+    int_vector_type * ready_list = status_count->ready_list[index];
+    for (int i = 0; i < int_vector_size( ready_list ); i++)
+      int_vector_append( index_list , int_vector_iget( ready_list , i ));
+    int_vector_reset( ready_list );
+  }
+  pthread_mutex_unlock( &status_count->update_mutex );
+}
+
+
+void job_queue_status_post_event( job_queue_status_type * status_count ) {
+  pthread_mutex_lock( &status_count->update_mutex );
+  status_count->event_count++;
+  pthread_cond_broadcast( &status_count->event_cond );
+  pthread_mutex_unlock( &status_count->update_mutex );
+}
+
+
+long job_queue_status_get_event_count( job_queue_status_type * status_count ) {
+  long event_count;
+  pthread_mutex_lock( &status_count->update_mutex );
+  event_count = status_count->event_count;
+  pthread_mutex_unlock( &status_count->update_mutex );
+  return event_count;
+}
+
+
+/*
+  Will wait until an event has occured since the event counter was
+  @event_count, or until @timeout_usec microseconds have passed.
+  Returns true if an event has occured.
+*/
+
+bool job_queue_status_wait_event( job_queue_status_type * status_count , long event_count , int timeout_usec) {
+  bool event = false;
+  struct timespec deadline;
+  {
+    struct timeval now;
+    long nsec;
+    gettimeofday( &now , NULL );
+    nsec = (now.tv_usec + (long) (timeout_usec % 1000000)) * 1000;
+    deadline.tv_sec  = now.tv_sec + timeout_usec / 1000000 + nsec / 1000000000;
+    deadline.tv_nsec = nsec % 1000000000;
+  }
+
+  pthread_mutex_lock( &status_count->update_mutex );
+  while (status_count->event_count == event_count) {
+    if (pthread_cond_timedwait( &status_count->event_cond , &status_count->update_mutex , &deadline ) == ETIMEDOUT)
+      break;
+  }
+  event = (status_count->event_count != event_count);
+  pthread_mutex_unlock( &status_count->update_mutex );
+  return event;
+}
+
+
 int job_queue_status_get_total_count( const job_queue_status_type * status ) {
   int total_count = 0;
   for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
@@ -33,10 +33,11 @@
 
 struct local_job_struct {
   UTIL_TYPE_ID_DECLARATION;
-  bool            active;
-  job_status_type status;
-  pthread_t       run_thread;
-  pid_t           child_process;
+  bool                 active;
+  job_status_type      status;
+  pthread_t            run_thread;
+  pid_t                child_process;
+  local_driver_type  * driver;
 };
 
 
@@ -45,8 +46,11 @@ struct local_job_struct {
 
 struct local_driver_struct {
   UTIL_TYPE_ID_DECLARATION;
-  pthread_attr_t     thread_attr;
-  pthread_mutex_t    submit_lock;
+  pthread_attr_t             thread_attr;
+  pthread_mutex_t            submit_lock;
+  pthread_mutex_t            event_lock;
+  queue_driver_event_ftype * event_callback;     /* Called when a job has completed - can be NULL. */
+  void                     * event_arg;
 };
 
 /*****************************************************************/
@@ -62,6 +66,7 @@ local_job_type * local_job_alloc() {
   UTIL_TYPE_ID_INIT( job , LOCAL_JOB_TYPE_ID );
   job->active = false;
   job->status = JOB_QUEUE_WAITING;
+  job->driver = NULL;
   return job;
 }
 
@@ -103,6 +108,23 @@ void local_driver_kill_job( void * __driver , void * __job) {
 }
 
 
+void local_driver_set_event_callback(void * __driver , queue_driver_event_ftype * callback , void * callback_arg) {
+  local_driver_type * driver = local_driver_safe_cast( __driver );
+  pthread_mutex_lock( &driver->event_lock );
+  driver->event_callback = callback;
+  driver->event_arg      = callback_arg;
+  pthread_mutex_unlock( &driver->event_lock );
+}
+
+
+static void local_driver_post_event( local_driver_type * driver ) {
+  pthread_mutex_lock( &driver->event_lock );
+  if (driver->event_callback)
+    driver->event_callback( driver->event_arg );
+  pthread_mutex_unlock( &driver->event_lock );
+}
+
+
 void * submit_job_thread__(void * __arg) {
   arg_pack_type *arg_pack = arg_pack_safe_cast(__arg);
   const char *executable = arg_pack_iget_const_ptr(arg_pack, 0);
@@ -115,6 +137,7 @@ void * submit_job_thread__(void * __arg) {
   int argc = arg_pack_iget_int(arg_pack, 2);
   char **argv = arg_pack_iget_ptr(arg_pack, 3);
   local_job_type *job = arg_pack_iget_ptr(arg_pack, 4);
+  local_driver_type * driver = job->driver;   /* The job can be freed as soon as the status is DONE. */
 
   {
     int wait_status;
@@ -126,6 +149,7 @@ void * submit_job_thread__(void * __arg) {
 
   job->status = JOB_QUEUE_DONE;
   job->active = false;
+  local_driver_post_event( driver );
   pthread_exit(NULL);
   return NULL;
 }
@@ -143,6 +167,7 @@ void * local_driver_submit_job(void * __driver           ,
   {
     local_job_type * job    = local_job_alloc();
     arg_pack_type  * arg_pack = arg_pack_alloc();
+    job->driver = driver;
     arg_pack_append_const_ptr( arg_pack , submit_cmd);
     arg_pack_append_const_ptr( arg_pack , run_path );
     arg_pack_append_int( arg_pack , argc );
@@ -180,6 +205,9 @@ void * local_driver_alloc() {
   local_driver_type * local_driver = util_malloc(sizeof * local_driver );
   UTIL_TYPE_ID_INIT( local_driver , LOCAL_DRIVER_TYPE_ID);
   pthread_mutex_init( &local_driver->submit_lock , NULL );
+  pthread_mutex_init( &local_driver->event_lock , NULL );
+  local_driver->event_callback = NULL;
+  local_driver->event_arg      = NULL;
   pthread_attr_init( &local_driver->thread_attr );
   pthread_attr_setdetachstate( &local_driver->thread_attr , PTHREAD_CREATE_DETACHED );
   
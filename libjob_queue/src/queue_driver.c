@@ -71,6 +71,7 @@ struct queue_driver_struct {
   get_option_ftype * get_option;
   has_option_ftype * has_option;
   init_option_list_ftype * init_options;
+  set_event_callback_ftype * set_event_callback; /* Optional: drivers which can notify the queue layer of status changes. */
 
   void * data; /* Driver specific data - passed as first argument to the driver functions above. */
 
@@ -184,6 +185,7 @@ static queue_driver_type * queue_driver_alloc_empty() {
   driver->data = NULL;
   driver->max_running_string = NULL;
   driver->init_options = NULL;
+  driver->set_event_callback = NULL;
 
   queue_driver_set_generic_option__(driver, MAX_RUNNING, "0");
 
@@ -228,6 +230,7 @@ queue_driver_type * queue_driver_alloc(job_driver_type type) {
       driver->free_driver = local_driver_free__;
       driver->name = util_alloc_string_copy("local");
       driver->init_options = local_driver_init_option_list;
+      driver->set_event_callback = local_driver_set_event_callback;
       driver->data = local_driver_alloc();
       break;
     case RSH_DRIVER:
@@ -359,6 +362,24 @@ job_status_type queue_driver_get_status(queue_driver_type * driver, void * job_d
   return status;
 }
 
+/*
+  Drivers which can detect status changes by themselves, i.e. without
+  being polled with queue_driver_get_status(), will call @callback
+  with @callback_arg when the status of one of the jobs has
+  changed. The callback can be called from any thread. Returns false
+  if the driver does not support status change events, in which case
+  the queue layer must rely on polling. Call with callback == NULL to
+  remove the callback.
+*/
+
+bool queue_driver_set_event_callback(queue_driver_type * driver, queue_driver_event_ftype * callback, void * callback_arg) {
+  if (driver->set_event_callback) {
+    driver->set_event_callback(driver->data, callback, callback_arg);
+    return true;
+  } else
+    return false;
+}
+
 void queue_driver_free_driver(queue_driver_type * driver) {
   driver->free_driver(driver->data);
 }
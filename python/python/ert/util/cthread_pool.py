@@ -25,7 +25,7 @@ class CThreadPool(BaseCClass):
 
     _alloc   = UtilPrototype("void* thread_pool_alloc(int, bool)", bind = False)
     _free    = UtilPrototype("void thread_pool_free(thread_pool)")
-    _add_job = UtilPrototype("void thread_pool_add_job(thread_pool, void*, void*)")
+    _add_job = UtilPrototype("int thread_pool_add_job(thread_pool, void*, void*)")
     _join    = UtilPrototype("void thread_pool_join(thread_pool)")
 
     def __init__(self, pool_size, start=True):
@@ -9,6 +9,7 @@ class UnixEnvironmentKeywords(object):
         ert_keywords.addKeyword(self.addSetEnv())
         ert_keywords.addKeyword(self.addUMask())
         ert_keywords.addKeyword(self.addUpdatePath())
+        ert_keywords.addKeyword(self.addMaxThreads())
 
 
 
@@ -31,6 +32,15 @@ class UnixEnvironmentKeywords(object):
         return umask
 
 
+    def addMaxThreads(self):
+        max_threads = ConfigurationLineDefinition(keyword=KeywordDefinition("MAX_THREADS"),
+                                                  arguments=[IntegerArgument(from_value=1)],
+                                                  documentation_link="keywords/max_threads",
+                                                  required=False,
+                                                  group=self.group)
+        return max_threads
+
+
     def addUpdatePath(self):
         update_path = ConfigurationLineDefinition(keyword=KeywordDefinition("UPDATE_PATH"),
                                                   arguments=[StringArgument(built_in=True), PathArgument()],
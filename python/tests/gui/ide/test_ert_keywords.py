@@ -180,6 +180,7 @@ class ErtKeywordTest(ExtendedTestCase):
     def test_unix_environment_keywords(self):
         self.keywordTest("SETENV", [StringArgument, StringArgument], "keywords/setenv", "Unix")
         self.keywordTest("UMASK", [IntegerArgument], "keywords/umask", "Unix")
+        self.keywordTest("MAX_THREADS", [IntegerArgument], "keywords/max_threads", "Unix")
         self.keywordTest("UPDATE_PATH", [StringArgument,PathArgument], "keywords/update_path", "Unix")
 
 